@@ -0,0 +1,197 @@
+#include "Harness.h"
+#include "Ball.h"
+#include "CrowdScene.h"
+#include "Game.h"
+#include "JobSystem.h"
+#include "Round.h"
+#include "ThrowSolver.h"
+#include "Walker.h"
+
+static constexpr float kDt = 1.0f / rounds::kTickRate;
+
+// ---- Walker::step, one case per stage of a round ----
+
+// the ball is out of reach, so the walker never stops; re-init now and
+// then to keep its x small
+static void walkForever(bench::State &state, bool walkCycle)
+{
+    Walker w({1e6f, 470.0f}, 20.0f);
+    w.init();
+    w.setWalkCycleCache(walkCycle);
+    int steps = 0;
+    while (state.next())
+    {
+        w.step();
+        if (++steps == 100000)
+        {
+            w.init();
+            steps = 0;
+        }
+    }
+    bench::doNotOptimize(w.getHandPos());
+}
+
+static void walkerWalkCycle(bench::State &state) { walkForever(state, true); }
+static void walkerLiveIK(bench::State &state) { walkForever(state, false); }
+
+// ball right in front of the start, so the walker reaches it on step one;
+// its pose would not change again, so the pose cache is off to time the
+// update rather than the early-out
+static Walker walkerAtBall(bool stand)
+{
+    Walker w({150.0f, 470.0f}, 20.0f);
+    w.init();
+    w.setPoseCache(false);
+    w.step();
+    w.setStandUp(stand);
+    return w;
+}
+
+static void walkerReaching(bench::State &state)
+{
+    Walker w = walkerAtBall(false);
+    while (state.next())
+        w.step();
+    bench::doNotOptimize(w.getHandPos());
+}
+
+static void walkerStanding(bench::State &state)
+{
+    Walker w = walkerAtBall(true);
+    while (state.next())
+        w.step();
+    bench::doNotOptimize(w.getHandPos());
+}
+
+static void walkerThrowing(bench::State &state)
+{
+    Walker w = walkerAtBall(true);
+    int frame = 0;
+    while (state.next())
+    {
+        frame = (frame + 1) % 24; // the 0.4 s throw animation at 60 Hz
+        w.setThrowAnim(1.0f, frame / 24.0f);
+        w.step();
+    }
+    bench::doNotOptimize(w.getHandPos());
+}
+
+static void walkerFingersTouching(bench::State &state)
+{
+    Walker w = walkerAtBall(false);
+    int touching = 0;
+    while (state.next())
+        touching += w.fingersTouchingBall();
+    bench::doNotOptimize(touching);
+}
+
+// ---- Walker update stages, one at a time on a walker reaching for its
+// ball, which takes the IK path in every stage ----
+
+struct WalkerStageBench
+{
+    using Stage = void (Walker::*)();
+
+    static void run(bench::State &state, Stage stage)
+    {
+        Walker w = walkerAtBall(false);
+        while (state.next())
+            (w.*stage)();
+        bench::doNotOptimize(w.getHandPos());
+    }
+
+    static void torso(bench::State &state) { run(state, &Walker::updateTorso); }
+    static void legs(bench::State &state) { run(state, &Walker::updateLegs); }
+    static void arms(bench::State &state) { run(state, &Walker::updateArms); }
+    static void fingers(bench::State &state) { run(state, &Walker::updateFingers); }
+};
+
+BENCHMARK("Walker::step/walk_cycle", walkerWalkCycle);
+BENCHMARK("Walker::step/live_ik", walkerLiveIK);
+BENCHMARK("Walker::step/reaching", walkerReaching);
+BENCHMARK("Walker::step/standing", walkerStanding);
+BENCHMARK("Walker::step/throwing", walkerThrowing);
+BENCHMARK("Walker::fingersTouchingBall", walkerFingersTouching);
+BENCHMARK("Walker::updateTorso", WalkerStageBench::torso);
+BENCHMARK("Walker::updateLegs", WalkerStageBench::legs);
+BENCHMARK("Walker::updateArms", WalkerStageBench::arms);
+BENCHMARK("Walker::updateFingers", WalkerStageBench::fingers);
+
+// ---- Ball ----
+
+static const Vector2 kHand = {180.0f, 330.0f};
+static const Vector2 kAim = {640.0f, 220.0f};
+
+static void ballThrowTo(bench::State &state)
+{
+    Ball ball({0, 0}, 20.0f, RED);
+    float time = 0.6f;
+    while (state.next())
+    {
+        ball.throwTo(kHand, kAim, rounds::kGravity, time);
+        time = time < 1.2f ? time + 0.001f : 0.6f;
+    }
+    bench::doNotOptimize(ball.vel);
+}
+
+// one tick of flight; a ball that landed is thrown again, with the
+// closed-form path when `predicted`
+static void ballFlight(bench::State &state, bool predicted)
+{
+    Ball ball({0, 0}, 20.0f, RED);
+    Circle aim = {kAim.x, kAim.y, 30.0f};
+    while (state.next())
+    {
+        if (ball.state != BALL_THROWN)
+        {
+            ball.throwTo(kHand, kAim, rounds::kGravity, rounds::kFlightTime);
+            if (predicted)
+                ball.predict(rounds::kGroundY, &aim, 1);
+        }
+        ball.update(rounds::kGravity, kDt, rounds::kGroundY);
+    }
+    bench::doNotOptimize(ball.pos);
+}
+
+static void ballUpdateIntegrated(bench::State &state) { ballFlight(state, false); }
+static void ballUpdatePredicted(bench::State &state) { ballFlight(state, true); }
+
+static void throwSolverSolve(bench::State &state)
+{
+    ThrowSolver solver;
+    float x = 100.0f;
+    while (state.next())
+    {
+        bench::doNotOptimize(solver.solve(kHand, {x, 220.0f}));
+        x = x < 800.0f ? x + 1.0f : 100.0f;
+    }
+}
+
+BENCHMARK("Ball::throwTo", ballThrowTo);
+BENCHMARK("Ball::update/integrated", ballUpdateIntegrated);
+BENCHMARK("Ball::update/predicted", ballUpdatePredicted);
+BENCHMARK("ThrowSolver::solve", throwSolverSolve);
+
+// ---- whole headless frames ----
+
+// the game's own loop: scripted input plus update, no rendering
+static void gameFrame(bench::State &state)
+{
+    Game game(900, 600, true, 1);
+    while (state.next())
+        game.stepHeadless(kDt);
+}
+
+// one tick of a crowd where every walker plays its own round
+static void crowdTick(bench::State &state)
+{
+    JobSystem jobs(1);
+    CrowdScene scene(static_cast<size_t>(state.arg()));
+    state.setItemsPerIteration(state.arg());
+    while (state.next())
+        scene.step(jobs);
+    bench::doNotOptimize(scene.stats().ticks);
+}
+
+BENCHMARK("Game::frame", gameFrame);
+BENCHMARK("CrowdScene::step", crowdTick, 1, 16, 256, 4096);
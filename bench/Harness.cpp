@@ -0,0 +1,188 @@
+#include "Harness.h"
+#include "Modes.h"
+#include "FastTrig.h"
+#include "Simd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+
+namespace bench
+{
+    std::vector<Case> &registry()
+    {
+        static std::vector<Case> cases;
+        return cases;
+    }
+}
+
+namespace
+{
+    struct Options
+    {
+        const char *filter = nullptr;
+        const char *jsonPath = nullptr;
+        double minTime = 0.2; // seconds per repetition
+        int repetitions = 5;
+        bool list = false;
+    };
+
+    struct Result
+    {
+        std::string name;
+        long iterations = 0;
+        double medianNs = 0.0, minNs = 0.0, meanNs = 0.0, stddevNs = 0.0;
+        double itemsPerSecond = 0.0;
+    };
+
+    double runOnce(const bench::Case &c, long arg, long iterations, long &items)
+    {
+        bench::State state(iterations, arg);
+        c.fn(state);
+        items = state.itemsProcessed();
+        return state.seconds();
+    }
+
+    Result measure(const bench::Case &c, long arg, const std::string &name, const Options &opt)
+    {
+        // grow the iteration count until one run fills min-time
+        long iterations = 1, items = 0;
+        for (;;)
+        {
+            double s = runOnce(c, arg, iterations, items);
+            if (s >= opt.minTime || iterations >= (1L << 40))
+                break;
+            double grow = s > 0.0 ? opt.minTime * 1.4 / s : 100.0;
+            iterations = static_cast<long>(iterations * std::min(std::max(grow, 2.0), 100.0));
+        }
+
+        std::vector<double> ns;
+        for (int r = 0; r < opt.repetitions; ++r)
+            ns.push_back(runOnce(c, arg, iterations, items) * 1e9 / iterations);
+
+        Result res;
+        res.name = name;
+        res.iterations = iterations;
+        std::vector<double> sorted = ns;
+        std::sort(sorted.begin(), sorted.end());
+        size_t n = sorted.size();
+        res.medianNs = n % 2 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+        res.minNs = sorted.front();
+        for (double v : ns)
+            res.meanNs += v / n;
+        for (double v : ns)
+            res.stddevNs += (v - res.meanNs) * (v - res.meanNs) / n;
+        res.stddevNs = std::sqrt(res.stddevNs);
+        if (items > 0)
+            res.itemsPerSecond = items * 1e9 / res.medianNs;
+        return res;
+    }
+
+    bool writeJson(const char *path, const char *executable, const std::vector<Result> &results)
+    {
+        FILE *f = std::fopen(path, "w");
+        if (!f)
+            return false;
+        char date[64];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+#ifdef NDEBUG
+        const char *buildType = "release";
+#else
+        const char *buildType = "debug";
+#endif
+#ifdef OOCATCHER_SIMD
+        const char *simdName = simd::Ops::name;
+#else
+        const char *simdName = "scalar";
+#endif
+        std::fprintf(f, "{\n  \"context\": {\n");
+        std::fprintf(f, "    \"date\": \"%s\",\n    \"executable\": \"%s\",\n", date, executable);
+        std::fprintf(f, "    \"num_cpus\": %u,\n    \"library_build_type\": \"%s\",\n",
+                     std::thread::hardware_concurrency(), buildType);
+        std::fprintf(f, "    \"simd\": \"%s\",\n    \"trig\": \"%s\"\n  },\n", simdName, trig::backendName);
+        std::fprintf(f, "  \"benchmarks\": [");
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result &r = results[i];
+            std::fprintf(f, "%s\n    {\n      \"name\": \"%s\",\n      \"run_name\": \"%s\",\n"
+                            "      \"run_type\": \"iteration\",\n      \"iterations\": %ld,\n"
+                            "      \"real_time\": %.3f,\n      \"cpu_time\": %.3f,\n      \"time_unit\": \"ns\",\n"
+                            "      \"min_time_ns\": %.3f,\n      \"stddev_ns\": %.3f",
+                         i ? "," : "", r.name.c_str(), r.name.c_str(), r.iterations,
+                         r.medianNs, r.medianNs, r.minNs, r.stddevNs);
+            if (r.itemsPerSecond > 0.0)
+                std::fprintf(f, ",\n      \"items_per_second\": %.1f", r.itemsPerSecond);
+            std::fprintf(f, "\n    }");
+        }
+        std::fprintf(f, "\n  ]\n}\n");
+        return std::fclose(f) == 0;
+    }
+}
+
+// usage: oocatcher_bench [--filter text] [--min-time seconds] [--repetitions n] [--json file] [--list]
+//        oocatcher_bench --bench walkers|ik|balls|impacts|batch|grid|throws|skeleton|entities|trig|walkcycle|jobs|world|raster [count]
+int main(int argc, char **argv)
+{
+    if (argc >= 3 && std::strcmp(argv[1], "--bench") == 0)
+        return runBenchMode(argv[2], argc >= 4 ? std::atol(argv[3]) : 0);
+
+    Options opt;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            opt.filter = argv[++i];
+        else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+            opt.minTime = std::max(std::atof(argv[++i]), 1e-3);
+        else if (std::strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc)
+            opt.repetitions = std::max(std::atoi(argv[++i]), 1);
+        else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            opt.jsonPath = argv[++i];
+        else if (std::strcmp(argv[i], "--list") == 0)
+            opt.list = true;
+        else
+        {
+            std::fprintf(stderr, "unknown option '%s'\n", argv[i]);
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    if (!opt.list)
+        std::printf("%-36s %14s %12s %12s %14s\n", "benchmark", "iterations", "median ns", "stddev", "items/s");
+    for (const bench::Case &c : bench::registry())
+    {
+        std::vector<long> args = c.args.empty() ? std::vector<long>{0} : c.args;
+        for (long arg : args)
+        {
+            std::string name = c.args.empty() ? c.name : std::string(c.name) + "/" + std::to_string(arg);
+            if (opt.filter && name.find(opt.filter) == std::string::npos)
+                continue;
+            if (opt.list)
+            {
+                std::printf("%s\n", name.c_str());
+                continue;
+            }
+            Result r = measure(c, arg, name, opt);
+            std::printf("%-36s %14ld %12.1f %11.1f%% ", r.name.c_str(), r.iterations, r.medianNs,
+                        r.medianNs > 0.0 ? 100.0 * r.stddevNs / r.medianNs : 0.0);
+            if (r.itemsPerSecond > 0.0)
+                std::printf("%14.4g\n", r.itemsPerSecond);
+            else
+                std::printf("%14s\n", "-");
+            std::fflush(stdout);
+            results.push_back(r);
+        }
+    }
+
+    if (opt.jsonPath && !writeJson(opt.jsonPath, argv[0], results))
+    {
+        std::fprintf(stderr, "could not write %s\n", opt.jsonPath);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Minimal benchmark harness for oocatcher_bench.
+//
+// A benchmark is a function that does its setup, then runs the measured
+// code once per `while (state.next())`. The runner picks an iteration
+// count that fills --min-time, repeats the run --repetitions times and
+// reports the median; --json writes the results in Google Benchmark's JSON
+// layout, so its compare.py can diff two runs.
+namespace bench
+{
+    class State
+    {
+    public:
+        State(long iterations, long arg) : iterations(iterations), argument(arg) {}
+
+        // true while there are iterations left; the clock runs from the
+        // first call to the last
+        bool next()
+        {
+            if (done == 0)
+                start = Clock::now();
+            if (done++ < iterations)
+                return true;
+            stop = Clock::now();
+            return false;
+        }
+
+        long arg() const { return argument; }
+        // work items per iteration, reported as items_per_second
+        void setItemsPerIteration(long items) { itemsPerIteration = items > 0 ? items : 0; }
+        long itemsProcessed() const { return itemsPerIteration; }
+        double seconds() const { return std::chrono::duration<double>(stop - start).count(); }
+        long iterationCount() const { return iterations; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+        long iterations;
+        long argument;
+        long done = 0;
+        long itemsPerIteration = 0;
+        Clock::time_point start, stop;
+    };
+
+    using Function = void (*)(State &);
+
+    struct Case
+    {
+        const char *name;
+        Function fn;
+        std::vector<long> args; // one run per argument, appended to the name
+    };
+
+    std::vector<Case> &registry();
+
+    struct Registration
+    {
+        template <class... Args>
+        Registration(const char *name, Function fn, Args... args)
+        {
+            registry().push_back({name, fn, {static_cast<long>(args)...}});
+        }
+    };
+
+    // keeps the compiler from proving a result unused
+    template <class T>
+    inline void doNotOptimize(const T &value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+}
+
+#define BENCH_JOIN2(a, b) a##b
+#define BENCH_JOIN(a, b) BENCH_JOIN2(a, b)
+// BENCHMARK("Name", function) or BENCHMARK("Name", function, 1, 16, 256)
+#define BENCHMARK(name, ...) \
+    static ::bench::Registration BENCH_JOIN(benchRegistration_, __LINE__)(name, __VA_ARGS__)
@@ -0,0 +1,1269 @@
+#include "Modes.h"
+#include "ThrowSolver.h"
+#include "Ballistics.h"
+#include "CrowdScene.h"
+#include "EntityStore.h"
+#include "JobSystem.h"
+#include "FastTrig.h"
+#include "SpatialGrid.h"
+#include "Skeleton.h"
+#include "SoftwareRenderer.h"
+#include "PrimitiveBatch.h"
+#include "Rng.h"
+#include "Round.h"
+#include "Target.h"
+#include "Ball.h"
+#include "BallSystem.h"
+#include "IK.h"
+#include "Walker.h"
+#include "WalkCycle.h"
+#include "WalkerPool.h"
+#include "World.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using BenchClock = std::chrono::steady_clock;
+
+// correctness bounds; a bench run that exceeds one exits with 1
+static constexpr float kMaxThrowMiss = 0.01f; // px, solved throw at its flight time
+static constexpr float kMaxPoseError = 0.01f; // px, any joint of a walker pose
+static constexpr float kMaxIKAngleError = 1e-4f; // rad, batched IK against the reference
+static constexpr float kMaxIKPositionError = 0.01f; // px, same
+static constexpr float kMaxImpactTimeError = 1e-4f; // s, predicted impact against sampled flight
+
+static double elapsedMs(BenchClock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - since).count();
+}
+
+// a ball laid out as the game lays out a round's
+static void randomBallFor(Rng &rng, Vector2 &center, float &radius)
+{
+    Ball ball = rounds::randomBall(rng, rounds::kStartX, rounds::kScreenW, rounds::kGroundY);
+    center = ball.getPos();
+    radius = ball.getRadius();
+}
+
+static float poseDistance(const WalkerPose &a, const WalkerPose &b)
+{
+    float worst = 0.0f;
+    auto cmp = [&worst](Vector2 p, Vector2 q)
+    { worst = std::max({worst, fabsf(p.x - q.x), fabsf(p.y - q.y)}); };
+    cmp(a.torsoBottom, b.torsoBottom);
+    cmp(a.torsoTop, b.torsoTop);
+    cmp(a.headCenter, b.headCenter);
+    const Limb2 *la[] = {&a.leftLeg, &a.rightLeg, &a.leftArm, &a.rightArm};
+    const Limb2 *lb[] = {&b.leftLeg, &b.rightLeg, &b.leftArm, &b.rightArm};
+    for (int i = 0; i < 4; ++i)
+    {
+        cmp(la[i]->root, lb[i]->root);
+        cmp(la[i]->joint, lb[i]->joint);
+        cmp(la[i]->tip, lb[i]->tip);
+    }
+    for (int i = 0; i < 3; ++i)
+        cmp(a.fingers[i].tip, b.fingers[i].tip);
+    return worst;
+}
+
+// worst distance from a skeleton bone's end to the pose joint it mirrors
+static float skeletonDistance(const Skeleton &skeleton, const WalkerPose &pose)
+{
+    float worst = 0.0f;
+    auto cmp = [&worst](Vector2 p, Vector2 q)
+    { worst = std::max({worst, fabsf(p.x - q.x), fabsf(p.y - q.y)}); };
+    cmp(skeleton[Walker::BONE_TORSO].end, pose.torsoTop);
+    const Limb2 *limbs[] = {&pose.leftLeg, &pose.rightLeg, &pose.leftArm, &pose.rightArm};
+    const int upper[] = {Walker::BONE_LEFT_THIGH, Walker::BONE_RIGHT_THIGH, Walker::BONE_LEFT_UPPER_ARM,
+                         Walker::BONE_RIGHT_UPPER_ARM};
+    for (int i = 0; i < 4; ++i)
+    {
+        cmp(skeleton[upper[i]].end, limbs[i]->joint);
+        cmp(skeleton[upper[i] + 1].end, limbs[i]->tip);
+    }
+    for (int i = 0; i < 3; ++i)
+        cmp(skeleton[Walker::BONE_FINGER + i].end, pose.fingers[i].tip);
+    return worst;
+}
+
+// Scripted round per walker: walk, reach, stand, wind up and throw.
+static void scriptWalker(int frame, size_t i, bool &stand, float &windup, float &fwd)
+{
+    int standAt = 380 + static_cast<int>(i % 7) * 10;
+    stand = frame >= standAt;
+    windup = fwd = 0.0f;
+    if (frame >= standAt + 20 && frame < standAt + 44)
+    {
+        windup = 1.0f;
+        fwd = (frame - standAt - 20) / 24.0f;
+    }
+}
+
+int benchWalkers(size_t maxWalkers)
+{
+    bool matches = true;
+    // --- correctness: pool vs scalar Walker, pose for pose, at two tick rates ---
+    for (float tickDt : {1.0f / 60.0f, 1.0f / 30.0f})
+    {
+        const size_t n = 256;
+        const int frames = 600;
+        Rng rng(1234);
+        std::vector<Walker> walkers;
+        WalkerPool pool(n, tickDt);
+        for (size_t i = 0; i < n; ++i)
+        {
+            Vector2 c;
+            float r;
+            randomBallFor(rng, c, r);
+            walkers.emplace_back(c, r);
+            walkers.back().init(100.0f, tickDt);
+            pool.add(c, r);
+        }
+
+        float worst = 0.0f, worstBone = 0.0f;
+        size_t touchMismatch = 0;
+        for (int f = 0; f < frames; ++f)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                bool stand;
+                float windup, fwd;
+                scriptWalker(f, i, stand, windup, fwd);
+                walkers[i].setStandUp(stand);
+                walkers[i].setThrowAnim(windup, fwd);
+                pool.setStandUp(i, stand);
+                pool.setThrowAnim(i, windup, fwd);
+                walkers[i].step();
+            }
+            pool.stepAll();
+            for (size_t i = 0; i < n; ++i)
+            {
+                worst = std::max(worst, poseDistance(walkers[i].getPose(), pool.pose(i)));
+                worstBone = std::max(worstBone, skeletonDistance(walkers[i].getSkeleton(), walkers[i].getPose()));
+                touchMismatch += walkers[i].fingersTouchingBall() != pool.fingersTouchingBall(i);
+            }
+        }
+        std::printf("WalkerPool vs Walker at %.0f Hz: %zu walkers x %d frames, max pose error %.6f px, "
+                    "%zu touch mismatches\n", 1.0f / tickDt, n, frames, worst, touchMismatch);
+        if (worst > kMaxPoseError || touchMismatch != 0)
+        {
+            std::printf("FAILED: WalkerPool off by more than %.2g px or touching differently\n", kMaxPoseError);
+            matches = false;
+        }
+        std::printf("Walker skeleton vs pose: max joint error %.6f px\n", worstBone);
+        if (worstBone > kMaxPoseError)
+        {
+            std::printf("FAILED: a skeleton joint is more than %.2g px from the pose\n", kMaxPoseError);
+            matches = false;
+        }
+    }
+
+    // --- throughput scaling ---
+    std::printf("%10s %16s %16s %8s\n", "walkers", "Walker/ms", "WalkerPool/ms", "speedup");
+    for (size_t n = 1; n <= maxWalkers; n *= 10)
+    {
+        const int frames = static_cast<int>(std::max<size_t>(60, 4000000 / n));
+        Rng rng(42);
+        std::vector<Walker> walkers;
+        WalkerPool pool(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            Vector2 c;
+            float r;
+            randomBallFor(rng, c, r);
+            walkers.emplace_back(c, r);
+            walkers.back().init();
+            // the pool poses every walker every tick, so must the scalar side
+            walkers.back().setPoseCache(false);
+            pool.add(c, r);
+        }
+
+        auto start = BenchClock::now();
+        for (int f = 0; f < frames; ++f)
+            for (auto &w : walkers)
+                w.step();
+        double scalarMs = elapsedMs(start);
+
+        start = BenchClock::now();
+        for (int f = 0; f < frames; ++f)
+            pool.stepAll();
+        double poolMs = elapsedMs(start);
+
+        double updates = static_cast<double>(n) * frames;
+        std::printf("%10zu %16.0f %16.0f %7.2fx\n", n, updates / scalarMs, updates / poolMs, scalarMs / poolMs);
+    }
+    return matches ? 0 : 1;
+}
+
+// Accuracy of solveTwoBoneBatch against the reference formulas, on the limb
+// configurations walkers actually produce plus a uniform sweep around the
+// root, followed by throughput of both paths.
+int benchIK(size_t limbs)
+{
+    std::vector<float> rootX, rootY, targetX, targetY, len1, len2, bend;
+    auto push = [&](Vector2 root, Vector2 target, float l1, float l2, float b)
+    {
+        rootX.push_back(root.x);
+        rootY.push_back(root.y);
+        targetX.push_back(target.x);
+        targetY.push_back(target.y);
+        len1.push_back(l1);
+        len2.push_back(l2);
+        bend.push_back(b);
+    };
+
+    // walker legs and reaching arms over a full walk + reach
+    Rng rng(7);
+    for (int w = 0; w < 64; ++w)
+    {
+        Vector2 c;
+        float r;
+        randomBallFor(rng, c, r);
+        Walker walker(c, r);
+        walker.init();
+        for (int f = 0; f < 400; ++f)
+        {
+            walker.step();
+            WalkerPose p = walker.getPose();
+            // the knee blend is internal to Walker, sweep the range the gait uses
+            float blend = 0.9f * (f % 16) / 15.0f;
+            push(p.leftLeg.root, p.leftLeg.tip, 46.0f, 44.0f, blend);
+            push(p.rightLeg.root, p.rightLeg.tip, 46.0f, 44.0f, blend);
+            push(p.rightArm.root, c, 38.0f, 34.0f, -1.0f);
+        }
+    }
+    // uniform sweep, including unreachable and degenerate targets
+    while (rootX.size() < limbs)
+    {
+        float ang = rng.unit() * 2 * PI;
+        float dist = rng.unit() * 120.0f;
+        float b = rng.below(2) ? -1.0f : rng.unit();
+        push({0, 0}, {dist * sinf(ang), dist * cosf(ang)}, 40.0f, 36.0f, b);
+    }
+
+    size_t n = rootX.size();
+    std::vector<float> ref[6], out[6];
+    for (int k = 0; k < 6; ++k)
+    {
+        ref[k].resize(n);
+        out[k].resize(n);
+    }
+    auto batchFor = [&](std::vector<float> *o)
+    {
+        return TwoBoneBatch{rootX.data(), rootY.data(), targetX.data(), targetY.data(),
+                            len1.data(), len2.data(), bend.data(),
+                            o[0].data(), o[1].data(), o[2].data(), o[3].data(), o[4].data(), o[5].data()};
+    };
+    TwoBoneBatch refBatch = batchFor(ref), outBatch = batchFor(out);
+
+    solveTwoBoneBatchScalar(refBatch, n);
+    solveTwoBoneBatch(outBatch, n);
+
+    float angleErr = 0.0f, posErr = 0.0f;
+    for (size_t i = 0; i < n; ++i)
+    {
+        angleErr = std::max({angleErr, fabsf(ref[0][i] - out[0][i]), fabsf(ref[1][i] - out[1][i])});
+        for (int k = 2; k < 6; ++k)
+            posErr = std::max(posErr, fabsf(ref[k][i] - out[k][i]));
+    }
+    std::printf("IK batch (%s) vs reference: %zu limbs, max angle error %.2e rad, max position error %.2e px\n",
+                ikBackendName(), n, angleErr, posErr);
+    bool accurate = angleErr <= kMaxIKAngleError && posErr <= kMaxIKPositionError;
+    if (!accurate)
+        std::printf("FAILED: IK batch error above %.0e rad / %.2g px\n", kMaxIKAngleError, kMaxIKPositionError);
+
+    const int reps = std::max<int>(1, static_cast<int>(20000000 / n));
+    auto start = BenchClock::now();
+    for (int r = 0; r < reps; ++r)
+        solveTwoBoneBatchScalar(refBatch, n);
+    double scalarMs = elapsedMs(start);
+
+    start = BenchClock::now();
+    for (int r = 0; r < reps; ++r)
+        solveTwoBoneBatch(outBatch, n);
+    double batchMs = elapsedMs(start);
+
+    double solves = static_cast<double>(n) * reps;
+    std::printf("%10s %16s %16s %8s\n", "limbs", "scalar/ms", "batch/ms", "speedup");
+    std::printf("%10zu %16.0f %16.0f %7.2fx\n", n, solves / scalarMs, solves / batchMs, scalarMs / batchMs);
+    return accurate ? 0 : 1;
+}
+
+// One throw per ball from a walker-height hand to a Game::randomTarget-like
+// spot, integrated for two seconds with the per-object Ball and BallSystem.
+int benchBalls(size_t count)
+{
+    const float gravity = 750.0f, flightTime = 0.9f, groundY = 500.0f, dt = 1.0f / 60.0f;
+    const int frames = 120;
+
+    std::srand(99);
+    std::vector<Ball> balls;
+    balls.reserve(count);
+    BallSystem system(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        float r = 16.0f + std::rand() % 18;
+        Vector2 hand = {150.0f + std::rand() % 600, 360.0f + std::rand() % 40};
+        Vector2 target = {100.0f + std::rand() % 700, 100.0f + std::rand() % 300};
+        balls.emplace_back(hand, r, RED);
+        balls.back().throwTo(hand, target, gravity, flightTime);
+        system.spawn(hand, r, RED);
+        system.throwTo(i, hand, target, gravity, flightTime);
+    }
+
+    double objectMs = 0.0, systemMs = 0.0;
+    size_t events = 0, mismatches = 0;
+    for (int f = 0; f < frames; ++f)
+    {
+        auto start = BenchClock::now();
+        for (auto &b : balls)
+            b.update(gravity, dt, groundY);
+        objectMs += elapsedMs(start);
+
+        start = BenchClock::now();
+        system.update(gravity, dt, groundY);
+        systemMs += elapsedMs(start);
+        events += system.events().size();
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        Vector2 p = system.getPos(i);
+        mismatches += balls[i].state != system.getState(i) ||
+                      fabsf(balls[i].pos.x - p.x) > 1e-3f || fabsf(balls[i].pos.y - p.y) > 1e-3f;
+    }
+
+    std::printf("BallSystem vs Ball: %zu balls x %d frames, %zu landing events, %zu mismatches\n",
+                count, frames, events, mismatches);
+    std::printf("%12s %14s %14s %8s\n", "", "ms/frame", "balls/ms", "speedup");
+    std::printf("%12s %14.3f %14.0f %8s\n", "Ball", objectMs / frames, count * frames / objectMs, "");
+    std::printf("%12s %14.3f %14.0f %7.2fx\n", "BallSystem", systemMs / frames, count * frames / systemMs, objectMs / systemMs);
+    return mismatches == 0 ? 0 : 1;
+}
+
+// First time in [lo, hi] where gap(t) <= 0, given gap(lo) > 0 >= gap(hi).
+template <class Gap>
+static double bisectContact(Gap gap, double lo, double hi)
+{
+    for (int it = 0; it < 60; ++it)
+    {
+        double mid = 0.5 * (lo + hi);
+        (gap(mid) > 0.0 ? lo : hi) = mid;
+    }
+    return hi;
+}
+
+// predictImpacts against the flight sampled every kSampleDt up to the
+// landing, with contacts refined by bisection: the ground time, and for
+// each target whether and when the ball first touches it. Throws pass
+// close to their targets, so hits, misses and grazes all occur. A first
+// touch that never goes kGraze px deep is a graze the samples cannot
+// place, so it is left out.
+int benchImpacts(size_t count)
+{
+    const float gravity = 750.0f, groundY = 500.0f;
+    const double kSampleDt = 1.0 / 4000.0;
+    const double kGraze = 0.05;
+    const size_t kTargets = 4;
+
+    std::srand(17);
+    std::vector<Trajectory> paths(count);
+    std::vector<float> radii(count);
+    std::vector<Circle> targets(count * kTargets);
+    for (size_t i = 0; i < count; ++i)
+    {
+        radii[i] = 16.0f + std::rand() % 18;
+        paths[i] = {{100.0f + std::rand() % 700, 300.0f + std::rand() % 120},
+                    {std::rand() % 1200 - 600.0f, -200.0f - std::rand() % 700},
+                    gravity};
+        for (size_t k = 0; k < kTargets; ++k)
+        {
+            // somewhere along the first two seconds, pushed off the path by
+            // up to twice the contact distance
+            Vector2 on = paths[i].at((std::rand() % 2000) * 0.001f);
+            float r = 22.0f + std::rand() % 15;
+            float reach = 2.0f * (r + radii[i]);
+            targets[i * kTargets + k] = {on.x + (std::rand() % 2001 - 1000) * 0.001f * reach,
+                                         on.y + (std::rand() % 2001 - 1000) * 0.001f * reach, r};
+        }
+    }
+
+    size_t hits = 0, misses = 0, falseHits = 0, grazes = 0, noGround = 0;
+    double worstTime = 0.0;
+    ImpactList impacts;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Trajectory &path = paths[i];
+        const float r = radii[i];
+        const Circle *t = &targets[i * kTargets];
+        if (!predictImpacts(path, r, groundY, t, kTargets, impacts))
+        {
+            ++noGround;
+            continue;
+        }
+
+        auto groundGap = [&](double time) { return groundY - r - path.at(static_cast<float>(time)).y; };
+        long steps = 0;
+        while (groundGap((steps + 1) * kSampleDt) > 0.0)
+            ++steps;
+        double land = bisectContact(groundGap, steps * kSampleDt, (steps + 1) * kSampleDt);
+        worstTime = std::max(worstTime, std::fabs(impacts[impacts.size() - 1].time - land));
+
+        for (size_t k = 0; k < kTargets; ++k)
+        {
+            auto gap = [&](double time)
+            {
+                Vector2 p = path.at(static_cast<float>(time));
+                double dx = p.x - t[k].x, dy = p.y - t[k].y;
+                return std::sqrt(dx * dx + dy * dy) - (r + t[k].radius);
+            };
+            // samples up to and including the landing; the first touch and
+            // how deep the ball gets before it leaves the target again
+            double closest = gap(0.0), first = closest <= 0.0 ? 0.0 : -1.0, firstDepth = closest;
+            bool firstDone = false;
+            for (long j = 1; j <= steps + 1; ++j)
+            {
+                double time = std::min(j * kSampleDt, land), g = gap(time);
+                closest = std::min(closest, g);
+                if (first < 0.0 && g <= 0.0)
+                {
+                    first = bisectContact(gap, time - kSampleDt, time);
+                    firstDepth = g;
+                }
+                else if (first >= 0.0 && !firstDone)
+                {
+                    firstDone = g > 0.0;
+                    firstDepth = std::min(firstDepth, g);
+                }
+            }
+            const Impact *predicted = nullptr;
+            for (const Impact &im : impacts)
+                if (im.kind == IMPACT_TARGET && im.target == static_cast<int>(k))
+                    predicted = &im;
+
+            if (closest > kGraze)
+                falseHits += predicted != nullptr;
+            else if (closest >= -kGraze)
+                ++grazes;
+            else if (!predicted)
+                ++misses;
+            else if (firstDepth > -kGraze && std::fabs(predicted->time - first) > kMaxImpactTimeError)
+                ++grazes; // grazed first, went in later; either pass could be "first"
+            else
+            {
+                ++hits;
+                worstTime = std::max(worstTime, std::fabs(predicted->time - first));
+            }
+        }
+    }
+
+    auto start = BenchClock::now();
+    size_t events = 0;
+    for (size_t i = 0; i < count; ++i)
+        if (predictImpacts(paths[i], radii[i], groundY, &targets[i * kTargets], kTargets, impacts))
+            events += impacts.size();
+    double ms = elapsedMs(start);
+
+    std::printf("predictImpacts vs flight sampled at %.0f Hz: %zu throws x %zu targets\n", 1.0 / kSampleDt, count,
+                kTargets);
+    std::printf("%zu hits, %zu misses, %zu false hits, %zu grazes skipped, %zu never landed, max time error %.2e s\n",
+                hits, misses, falseHits, grazes, noGround, worstTime);
+    std::printf("%12s %14s\n%12s %14.0f   (%zu impacts)\n", "", "throws/ms", "predict", count / ms, events);
+    bool matches = misses == 0 && falseHits == 0 && noGround == 0 && worstTime <= kMaxImpactTimeError;
+    if (!matches)
+        std::printf("FAILED: a missed or false impact, or one more than %.0e s off\n", kMaxImpactTimeError);
+    return matches ? 0 : 1;
+}
+
+// Crowd scene of walkers, balls and targets recorded into a PrimitiveBatch.
+// Without a GL context only build() runs; its counters are what submit()
+// would send. Every command used to be at least one raylib draw call.
+int benchBatch(size_t maxWalkers)
+{
+    std::printf("%10s %14s %12s %12s %12s\n", "walkers", "commands", "draw calls", "vertices", "build ms");
+    for (size_t n = 1; n <= maxWalkers; n *= 10)
+    {
+        Rng rng(5);
+        WalkerPool pool(n);
+        std::vector<Ball> balls;
+        std::vector<Target> targets;
+        for (size_t i = 0; i < n; ++i)
+        {
+            Vector2 c;
+            float r;
+            randomBallFor(rng, c, r);
+            pool.add(c, r);
+            balls.emplace_back(c, r, ORANGE);
+            targets.push_back(rounds::randomTarget(rng, 0.0f, rounds::kScreenW, rounds::kGroundY));
+        }
+        for (int f = 0; f < 120; ++f)
+            pool.stepAll();
+
+        PrimitiveBatch batch;
+        const int frames = 20;
+        PrimitiveBatch::Stats s;
+        auto start = BenchClock::now();
+        for (int f = 0; f < frames; ++f)
+        {
+            batch.setLayer(0);
+            for (size_t i = 0; i < n; ++i)
+                Walker::draw(pool.pose(i), batch);
+            batch.setLayer(1);
+            for (const Ball &b : balls)
+                b.draw(batch, b.pos);
+            batch.setLayer(2);
+            Target::drawAll(targets.data(), targets.size(), batch);
+            s = batch.build();
+            batch.clear();
+        }
+        double ms = elapsedMs(start) / frames;
+        std::printf("%10zu %14d %12d %12d %12.3f\n", n, s.primitives, s.drawCalls, s.vertices, ms);
+    }
+    return 0;
+}
+
+// Finger tips against balls (point-in-circle) and balls against targets
+// (circle-circle) for a crowd spread over a world that grows with it, brute
+// force versus a SpatialGrid rebuilt every frame.
+int benchGrid(size_t maxWalkers)
+{
+    std::printf("%10s %12s %14s %14s %12s %8s\n", "walkers", "hits", "brute ms", "grid ms", "rebuild ms", "speedup");
+    int mismatches = 0;
+    for (size_t n = 100; n <= maxWalkers; n *= 10)
+    {
+        std::srand(11);
+        float worldW = 900.0f * std::max<size_t>(1, n / 20);
+        WalkerPool pool(n);
+        std::vector<Circle> balls(n), targets(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            float r = 16.0f + std::rand() % 18;
+            float x = std::rand() / (float)RAND_MAX * worldW;
+            balls[i] = {x, 500.0f - r - std::rand() % 201, r};
+            targets[i] = {std::rand() / (float)RAND_MAX * worldW, 100.0f + std::rand() % 300, 22.0f + std::rand() % 15};
+            pool.add({balls[i].x, balls[i].y}, r);
+        }
+        for (int f = 0; f < 200; ++f)
+            pool.stepAll();
+
+        std::vector<Vector2> tips;
+        for (size_t i = 0; i < n; ++i)
+            for (const Finger2 &f : pool.pose(i).fingers)
+                tips.push_back(f.tip);
+
+        // brute force
+        auto start = BenchClock::now();
+        size_t bruteHits = 0;
+        for (Vector2 p : tips)
+            for (const Circle &b : balls)
+                bruteHits += CheckCollisionPointCircle(p, {b.x, b.y}, b.radius + 1.0f);
+        for (const Circle &b : balls)
+            for (const Circle &t : targets)
+                bruteHits += CheckCollisionCircles({b.x, b.y}, b.radius, {t.x, t.y}, t.radius);
+        double bruteMs = elapsedMs(start);
+
+        // grid: balls and targets live in separate grids, rebuilt as a fresh frame would
+        start = BenchClock::now();
+        SpatialGrid ballGrid, targetGrid;
+        for (const Circle &b : balls)
+            ballGrid.insert({b.x, b.y, b.radius + 1.0f});
+        for (const Circle &t : targets)
+            targetGrid.insert(t);
+        ballGrid.rebuild();
+        targetGrid.rebuild();
+        double rebuildMs = elapsedMs(start);
+
+        std::vector<int> found;
+        for (Vector2 p : tips)
+            ballGrid.queryPoint(p, found);
+        for (const Circle &b : balls)
+            targetGrid.queryCircle(b, found);
+        double gridMs = elapsedMs(start);
+
+        bool match = found.size() == bruteHits;
+        mismatches += !match;
+        std::printf("%10zu %12zu %14.3f %14.3f %12.3f %7.1fx%s\n", n, found.size(), bruteMs, gridMs, rebuildMs,
+                    bruteMs / gridMs, match ? "" : "  MISMATCH");
+    }
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Hand -> target pairs spread over the solver's table. Every solution must
+// pass through its target; the table answer is compared with the direct
+// search for feasibility and preferred-angle error, then both are timed.
+int benchThrows(size_t count)
+{
+    ThrowSolver solver;
+    const ThrowConstraints &c = solver.constraints();
+
+    std::srand(21);
+    std::vector<Vector2> from(count), to(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        from[i] = {100.0f + std::rand() % 700, 330.0f + std::rand() % 80};
+        to[i] = {from[i].x + (std::rand() % 1800 - 900), 60.0f + std::rand() % 400};
+    }
+
+    float worstMiss = 0.0f, worstAngleGap = 0.0f;
+    size_t feasible = 0, disagree = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        ThrowSolution s = solver.solve(from[i], to[i]);
+        ThrowSolution d = solver.solveDirect(from[i], to[i]);
+        Vector2 end = Trajectory{from[i], s.velocity, c.gravity}.at(s.time);
+        worstMiss = std::max({worstMiss, fabsf(end.x - to[i].x), fabsf(end.y - to[i].y)});
+        feasible += s.feasible;
+        disagree += s.feasible != d.feasible;
+
+        auto angleOf = [&c](const ThrowSolution &t)
+        { return fabsf(atan2f(-t.velocity.y, fabsf(t.velocity.x)) - c.preferredAngle); };
+        if (s.feasible && d.feasible)
+            worstAngleGap = std::max(worstAngleGap, angleOf(s) - angleOf(d));
+    }
+    std::printf("ThrowSolver: %zu throws, %zu feasible, %zu feasibility disagreements with direct search\n",
+                count, feasible, disagree);
+    std::printf("             worst miss at flight time %.2e px, worst extra angle error vs direct %.4f rad\n",
+                worstMiss, worstAngleGap);
+    bool onTarget = worstMiss <= kMaxThrowMiss;
+    if (!onTarget)
+        std::printf("             FAILED: a solved throw misses its target by more than %.2g px\n", kMaxThrowMiss);
+
+    float sink = 0.0f;
+    auto start = BenchClock::now();
+    for (size_t i = 0; i < count; ++i)
+        sink += solver.solve(from[i], to[i]).time;
+    double tableMs = elapsedMs(start);
+    start = BenchClock::now();
+    for (size_t i = 0; i < count; ++i)
+        sink += solver.solveDirect(from[i], to[i]).time;
+    double directMs = elapsedMs(start);
+    std::printf("%12s %14s\n", "", "throws/ms");
+    std::printf("%12s %14.0f\n%12s %14.0f   (checksum %.1f)\n", "table", count / tableMs, "direct", count / directMs, sink);
+    return onTarget ? 0 : 1;
+}
+
+// The previous segment layout: one heap node per bone, linked by pointer
+// and updated by following parent->end.
+struct LinkedSegment
+{
+    Vector2 start, end;
+    float length, angle, minAngle, maxAngle, worldAngle;
+    LinkedSegment *parent;
+
+    void update()
+    {
+        angle = std::clamp(angle, minAngle, maxAngle);
+        worldAngle = angle;
+        if (parent)
+        {
+            start = parent->end;
+            worldAngle += parent->worldAngle;
+        }
+        float rad = DEG2RAD * worldAngle;
+        end = {start.x + cosf(rad) * length, start.y + sinf(rad) * length};
+    }
+};
+
+// A Skeleton keeps kInlineSegments bones inline whether it uses them or
+// not. One Skeleton per 4-bone chain is therefore mostly empty slots, and
+// solve() streams several times the memory the linked nodes take; that is
+// the "per chain" column. The "arena" column packs many chains into one
+// multi-root Skeleton of about kArenaSegments bones, the contiguous layout
+// the arena is meant for.
+int benchSkeleton(size_t maxDepth)
+{
+    const size_t segmentsPerRun = 1 << 18;
+    const size_t kArenaSegments = 1024;
+    const int frames = 20;
+    std::printf("FK over %zu segments per frame, chains of the given depth\n", segmentsPerRun);
+    std::printf("%8s %8s %16s %16s %16s %10s\n", "depth", "chains", "linked seg/ms", "per chain seg/ms",
+                "arena seg/ms", "max diff");
+
+    bool matches = true;
+    for (size_t depth = 4; depth <= maxDepth; depth *= 4)
+    {
+        size_t chains = segmentsPerRun / depth;
+        size_t perArena = std::max<size_t>(1, kArenaSegments / depth);
+        std::srand(11);
+
+        // built as a game would over time: bones of different skeletons
+        // allocated interleaved, so a chain is scattered across the heap
+        std::vector<Skeleton> own(chains), arenas((chains + perArena - 1) / perArena);
+        std::vector<LinkedSegment *> linked(chains * depth);
+        for (size_t d = 0; d < depth; ++d)
+            for (size_t c = 0; c < chains; ++c)
+            {
+                float angle = (std::rand() % 800 - 400) * 0.1f;
+                LinkedSegment *s = new LinkedSegment{{0, 0}, {0, 0}, 12.0f, angle, -30.0f, 30.0f, 0.0f,
+                                                     d ? linked[c * depth + d - 1] : nullptr};
+                if (!d)
+                    s->start = {static_cast<float>(c % 900), 300.0f};
+                linked[c * depth + d] = s;
+
+                int i = own[c].add(12.0f, -30.0f, 30.0f, d ? static_cast<int>(d) - 1 : -1);
+                own[c].setAngle(i, angle);
+                if (!d)
+                    own[c].setRoot(i, s->start);
+
+                // in an arena, bone d of its chains follows bone d - 1 of all of them
+                Skeleton &arena = arenas[c / perArena];
+                int slot = static_cast<int>(c % perArena);
+                i = arena.add(12.0f, -30.0f, 30.0f, d ? static_cast<int>((d - 1) * perArena) + slot : -1);
+                arena.setAngle(i, angle);
+                if (!d)
+                    arena.setRoot(i, s->start);
+            }
+
+        auto start = BenchClock::now();
+        for (int f = 0; f < frames; ++f)
+            for (LinkedSegment *s : linked)
+                s->update();
+        double linkedMs = elapsedMs(start);
+
+        start = BenchClock::now();
+        for (int f = 0; f < frames; ++f)
+            for (Skeleton &s : own)
+                s.solve();
+        double ownMs = elapsedMs(start);
+
+        start = BenchClock::now();
+        for (int f = 0; f < frames; ++f)
+            for (Skeleton &s : arenas)
+                s.solve();
+        double arenaMs = elapsedMs(start);
+
+        float worst = 0.0f;
+        for (size_t c = 0; c < chains; ++c)
+            for (size_t d = 0; d < depth; ++d)
+            {
+                Vector2 a = linked[c * depth + d]->end, b = own[c][d].end;
+                Vector2 e = arenas[c / perArena][d * perArena + c % perArena].end;
+                worst = std::max({worst, fabsf(a.x - b.x), fabsf(a.y - b.y), fabsf(a.x - e.x), fabsf(a.y - e.y)});
+            }
+        for (LinkedSegment *s : linked)
+            delete s;
+
+        double total = static_cast<double>(chains * depth) * frames;
+        std::printf("%8zu %8zu %16.0f %16.0f %16.0f %10.2e\n", depth, chains, total / linkedMs, total / ownMs,
+                    total / arenaMs, worst);
+        matches = matches && worst <= kMaxPoseError;
+    }
+    if (!matches)
+        std::printf("FAILED: a Skeleton bone ends more than %.2g px from its linked segment\n", kMaxPoseError);
+    return matches ? 0 : 1;
+}
+
+// The interface catchers used to share: one heap object per entity,
+// stepped and drawn through virtual calls.
+struct VirtualCatcher
+{
+    virtual void init() = 0;
+    virtual void step() = 0;
+    virtual void draw(PrimitiveBatch &batch) const = 0;
+    virtual ~VirtualCatcher() = default;
+};
+
+template <class Kind>
+struct VirtualAdapter : VirtualCatcher
+{
+    Kind entity;
+    template <class... Args>
+    explicit VirtualAdapter(Args &&...args) : entity(std::forward<Args>(args)...) {}
+    void init() override { entity.init(); }
+    void step() override { entity.step(); }
+    void draw(PrimitiveBatch &batch) const override { entity.draw(batch); }
+};
+
+int benchEntities(size_t count)
+{
+    const int frames = 120;
+    Rng rng(5);
+    std::vector<Vector2> centers(count);
+    std::vector<float> radii(count);
+    for (size_t i = 0; i < count; ++i)
+        randomBallFor(rng, centers[i], radii[i]);
+
+    std::vector<std::unique_ptr<VirtualCatcher>> virtualCrowd;
+    EntityStore<Walker> store;
+    store.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        virtualCrowd.push_back(std::make_unique<VirtualAdapter<Walker>>(centers[i], radii[i]));
+        virtualCrowd.back()->init();
+        store.add<Walker>(centers[i], radii[i]);
+    }
+
+    PrimitiveBatch batch;
+    double virtualStep = 0, virtualDraw = 0, storeStep = 0, storeDraw = 0;
+    for (int f = 0; f < frames; ++f)
+    {
+        auto start = BenchClock::now();
+        for (auto &c : virtualCrowd)
+            c->step();
+        virtualStep += elapsedMs(start);
+
+        batch.clear();
+        start = BenchClock::now();
+        for (auto &c : virtualCrowd)
+            c->draw(batch);
+        virtualDraw += elapsedMs(start);
+
+        start = BenchClock::now();
+        store.stepAll();
+        storeStep += elapsedMs(start);
+
+        batch.clear();
+        start = BenchClock::now();
+        store.drawAll(batch);
+        storeDraw += elapsedMs(start);
+    }
+
+    float worst = 0.0f;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Walker &a = static_cast<VirtualAdapter<Walker> &>(*virtualCrowd[i]).entity;
+        worst = std::max(worst, poseDistance(a.getPose(), store.get<Walker>(i).getPose()));
+    }
+
+    std::printf("%zu walkers, %d frames, max pose difference %.2e px\n", count, frames, worst);
+    std::printf("%14s %14s %14s\n", "", "step ms/frame", "draw ms/frame");
+    std::printf("%14s %14.3f %14.3f\n", "virtual", virtualStep / frames, virtualDraw / frames);
+    std::printf("%14s %14.3f %14.3f\n", "EntityStore", storeStep / frames, storeDraw / frames);
+    if (worst > kMaxPoseError)
+    {
+        std::printf("FAILED: EntityStore walkers more than %.2g px from the virtual ones\n", kMaxPoseError);
+        return 1;
+    }
+    return 0;
+}
+
+// Inputs of the walker's trig calls, gathered from a scripted crowd: phase
+// terms of t, every limb and finger angle, and the IK acos/atan2 arguments.
+struct TrigInputs
+{
+    std::vector<float> angles;     // sin / cos
+    std::vector<float> ratios;     // acos
+    std::vector<float> ys, xs;     // atan2
+};
+
+static TrigInputs walkerTrigInputs(size_t walkers)
+{
+    TrigInputs in;
+    const int frames = 600;
+    Rng rng(3);
+    std::vector<Walker> crowd;
+    std::vector<Vector2> balls(walkers);
+    for (size_t i = 0; i < walkers; ++i)
+    {
+        float radius;
+        randomBallFor(rng, balls[i], radius);
+        crowd.emplace_back(balls[i], radius);
+        crowd.back().init();
+    }
+
+    for (int f = 0; f < frames; ++f)
+    {
+        float t = f * 2 * PI / 48.0f;
+        for (float a : {t, 2 * t, t + PI, t + 0.5f, t + PI + 0.5f})
+            in.angles.push_back(a);
+
+        for (size_t i = 0; i < walkers; ++i)
+        {
+            bool stand;
+            float windup, fwd;
+            scriptWalker(f, i, stand, windup, fwd);
+            crowd[i].setStandUp(stand);
+            crowd[i].setThrowAnim(windup, fwd);
+            crowd[i].step();
+
+            WalkerPose p = crowd[i].getPose();
+            for (const Limb2 *l : {&p.leftLeg, &p.rightLeg, &p.leftArm, &p.rightArm})
+            {
+                in.angles.push_back(l->theta1);
+                in.angles.push_back(l->theta1 + l->theta2);
+                in.angles.push_back(l->theta1 - l->theta2);
+                float dx = l->tip.x - l->root.x, dy = l->tip.y - l->root.y;
+                float len = std::min(sqrtf(dx * dx + dy * dy), l->len1 + l->len2 - 1.0f);
+                in.ratios.push_back(std::clamp((l->len1 * l->len1 + len * len - l->len2 * l->len2) / (2 * l->len1 * len), -1.0f, 1.0f));
+                in.ratios.push_back(std::clamp((l->len1 * l->len1 + l->len2 * l->len2 - len * len) / (2 * l->len1 * l->len2), -1.0f, 1.0f));
+                in.ys.push_back(dx);
+                in.xs.push_back(dy);
+            }
+            for (const Finger2 &fg : p.fingers)
+                in.angles.push_back(fg.angle);
+            in.ys.push_back(balls[i].x - p.torsoBottom.x);
+            in.xs.push_back(balls[i].y - p.torsoBottom.y);
+        }
+    }
+    return in;
+}
+
+int benchTrig(size_t walkers)
+{
+    TrigInputs in = walkerTrigInputs(walkers);
+    size_t na = in.angles.size(), nr = in.ratios.size(), nt = in.xs.size();
+    std::printf("walker trig inputs from %zu walkers: %zu sin/cos, %zu acos, %zu atan2 (build uses %s)\n",
+                walkers, na, nr, nt, trig::backendName);
+
+    // batch kernels; the SIMD ones fall back to the scalar polynomial for the tail
+    using Unary = void (*)(const float *, float *, size_t);
+    auto libmSin = [](const float *x, float *o, size_t n) { for (size_t i = 0; i < n; ++i) o[i] = sinf(x[i]); };
+    auto polySin = [](const float *x, float *o, size_t n) { for (size_t i = 0; i < n; ++i) o[i] = trig::polySin(x[i]); };
+    auto tableSin = [](const float *x, float *o, size_t n) { for (size_t i = 0; i < n; ++i) o[i] = trig::tableSin(x[i]); };
+    auto libmCos = [](const float *x, float *o, size_t n) { for (size_t i = 0; i < n; ++i) o[i] = cosf(x[i]); };
+    auto polyCos = [](const float *x, float *o, size_t n) { for (size_t i = 0; i < n; ++i) o[i] = trig::polyCos(x[i]); };
+    auto tableCos = [](const float *x, float *o, size_t n) { for (size_t i = 0; i < n; ++i) o[i] = trig::tableCos(x[i]); };
+    auto libmAcos = [](const float *x, float *o, size_t n) { for (size_t i = 0; i < n; ++i) o[i] = acosf(x[i]); };
+    auto polyAcos = [](const float *x, float *o, size_t n) { for (size_t i = 0; i < n; ++i) o[i] = trig::polyAcos(x[i]); };
+#ifdef OOCATCHER_SIMD
+    using simd::Ops;
+    auto simdSin = [](const float *x, float *o, size_t n)
+    {
+        size_t i = 0;
+        for (; i + Ops::width <= n; i += Ops::width)
+            Ops::store(o + i, trig::sinv(Ops::load(x + i)));
+        for (; i < n; ++i)
+            o[i] = trig::polySin(x[i]);
+    };
+    auto simdCos = [](const float *x, float *o, size_t n)
+    {
+        size_t i = 0;
+        for (; i + Ops::width <= n; i += Ops::width)
+            Ops::store(o + i, trig::cosv(Ops::load(x + i)));
+        for (; i < n; ++i)
+            o[i] = trig::polyCos(x[i]);
+    };
+    auto simdAcos = [](const float *x, float *o, size_t n)
+    {
+        size_t i = 0;
+        for (; i + Ops::width <= n; i += Ops::width)
+            Ops::store(o + i, trig::acosv(Ops::load(x + i)));
+        for (; i < n; ++i)
+            o[i] = trig::polyAcos(x[i]);
+    };
+#endif
+
+    using Binary = void (*)(const float *, const float *, float *, size_t);
+    Binary libmAtan2 = [](const float *y, const float *x, float *o, size_t n)
+    { for (size_t i = 0; i < n; ++i) o[i] = atan2f(y[i], x[i]); };
+    Binary polyAtan2 = [](const float *y, const float *x, float *o, size_t n)
+    { for (size_t i = 0; i < n; ++i) o[i] = trig::polyAtan2(y[i], x[i]); };
+#ifdef OOCATCHER_SIMD
+    Binary simdAtan2 = [](const float *y, const float *x, float *o, size_t n)
+    {
+        size_t i = 0;
+        for (; i + Ops::width <= n; i += Ops::width)
+            Ops::store(o + i, trig::atan2v(Ops::load(y + i), Ops::load(x + i)));
+        for (; i < n; ++i)
+            o[i] = trig::polyAtan2(y[i], x[i]);
+    };
+#endif
+
+    const int reps = 20;
+    std::vector<float> ref(std::max({na, nr, nt})), out(ref.size());
+    std::printf("%-8s %-7s %12s %12s %10s\n", "func", "impl", "max |err|", "rms err", "ns/call");
+
+    auto report = [&](const char *func, const char *impl, size_t n, auto &&run)
+    {
+        run(out.data());
+        double worst = 0.0, sq = 0.0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            double e = std::fabs(static_cast<double>(out[i]) - ref[i]);
+            worst = std::max(worst, e);
+            sq += e * e;
+        }
+        auto start = BenchClock::now();
+        for (int r = 0; r < reps; ++r)
+            run(out.data());
+        double ns = elapsedMs(start) * 1e6 / (static_cast<double>(n) * reps);
+        std::printf("%-8s %-7s %12.2e %12.2e %10.2f\n", func, impl, worst, std::sqrt(sq / n), ns);
+    };
+    auto unary = [&](const char *func, const std::vector<float> &x, Unary reference,
+                     std::initializer_list<std::pair<const char *, Unary>> impls)
+    {
+        reference(x.data(), ref.data(), x.size());
+        for (auto &impl : impls)
+            report(func, impl.first, x.size(), [&](float *o) { impl.second(x.data(), o, x.size()); });
+    };
+
+    unary("sin", in.angles, libmSin, {{"libm", libmSin}, {"poly", polySin}, {"table", tableSin},
+#ifdef OOCATCHER_SIMD
+                                      {"simd", simdSin}
+#endif
+                                     });
+    unary("cos", in.angles, libmCos, {{"libm", libmCos}, {"poly", polyCos}, {"table", tableCos},
+#ifdef OOCATCHER_SIMD
+                                      {"simd", simdCos}
+#endif
+                                     });
+    unary("acos", in.ratios, libmAcos, {{"libm", libmAcos}, {"poly", polyAcos},
+#ifdef OOCATCHER_SIMD
+                                        {"simd", simdAcos}
+#endif
+                                       });
+
+    libmAtan2(in.ys.data(), in.xs.data(), ref.data(), nt);
+    std::pair<const char *, Binary> atan2Impls[] = {{"libm", libmAtan2}, {"poly", polyAtan2},
+#ifdef OOCATCHER_SIMD
+                                                    {"simd", simdAtan2}
+#endif
+    };
+    for (auto &impl : atan2Impls)
+        report("atan2", impl.first, nt, [&](float *o) { impl.second(in.ys.data(), in.xs.data(), o, nt); });
+    return 0;
+}
+
+int benchWalkCycle(size_t count)
+{
+    // tolerance: full scripted rounds, baked gait against live IK
+    const int frames = 600;
+    Rng rng(9);
+    std::vector<Walker> cached, live;
+    for (size_t i = 0; i < count; ++i)
+    {
+        Vector2 center;
+        float radius;
+        randomBallFor(rng, center, radius);
+        cached.emplace_back(center, radius);
+        live.emplace_back(center, radius);
+        cached.back().init();
+        live.back().init();
+        live.back().setWalkCycleCache(false);
+    }
+
+    float worst = 0.0f;
+    size_t touchMismatches = 0;
+    for (int f = 0; f < frames; ++f)
+        for (size_t i = 0; i < count; ++i)
+        {
+            bool stand;
+            float windup, fwd;
+            scriptWalker(f, i, stand, windup, fwd);
+            for (Walker *w : {&cached[i], &live[i]})
+            {
+                w->setStandUp(stand);
+                w->setThrowAnim(windup, fwd);
+                w->step();
+            }
+            worst = std::max(worst, poseDistance(cached[i].getPose(), live[i].getPose()));
+            touchMismatches += cached[i].fingersTouchingBall() != live[i].fingersTouchingBall();
+        }
+    std::printf("WalkCycle vs live IK: %zu walkers x %d frames, max pose error %.2e px, %zu touch mismatches\n",
+                count, frames, worst, touchMismatches);
+    bool matches = worst <= kMaxPoseError && touchMismatches == 0;
+    if (!matches)
+        std::printf("FAILED: baked gait off by more than %.2g px or touching differently\n", kMaxPoseError);
+
+    // throughput: a crowd that never reaches its ball walks the whole time
+    const int walkFrames = 240;
+    auto stepsPerMs = [&](bool useCache)
+    {
+        std::vector<Walker> crowd;
+        crowd.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            crowd.emplace_back(Vector2{INFINITY, 0.0f}, 20.0f);
+            crowd.back().init();
+            crowd.back().setWalkCycleCache(useCache);
+        }
+        auto start = BenchClock::now();
+        for (int f = 0; f < walkFrames; ++f)
+            for (Walker &w : crowd)
+                w.step();
+        return count * walkFrames / elapsedMs(start);
+    };
+    Walker::walkCycle();
+    double liveRate = stepsPerMs(false), cachedRate = stepsPerMs(true);
+    std::printf("%12s %16s\n", "", "walker steps/ms");
+    std::printf("%12s %16.0f\n%12s %16.0f   %.2fx\n", "live", liveRate, "baked", cachedRate, cachedRate / liveRate);
+    return matches ? 0 : 1;
+}
+
+int benchJobs(size_t count)
+{
+    const int ticks = 300;
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned t = 1; t < hw; t *= 2)
+        threadCounts.push_back(t);
+    threadCounts.push_back(hw);
+
+    std::printf("CrowdScene: %zu walkers, %d ticks, %u hardware threads\n", count, ticks, hw);
+    std::printf("%8s %12s %9s %18s %8s %6s\n", "threads", "ms/tick", "speedup", "state hash", "throws", "hits");
+    double base = 0.0;
+    uint64_t reference = 0;
+    bool deterministic = true;
+    for (unsigned threads : threadCounts)
+    {
+        JobSystem jobs(threads);
+        CrowdScene scene(count, 7);
+        auto start = BenchClock::now();
+        for (int t = 0; t < ticks; ++t)
+            scene.step(jobs);
+        double ms = elapsedMs(start) / ticks;
+
+        uint64_t hash = scene.stateHash();
+        if (threads == 1)
+        {
+            base = ms;
+            reference = hash;
+        }
+        deterministic = deterministic && hash == reference;
+        std::printf("%8u %12.3f %8.2fx %18llx %8ld %6ld\n", threads, ms, base / ms,
+                    static_cast<unsigned long long>(hash), scene.stats().throws, scene.stats().hits);
+    }
+    std::printf("same state on every thread count: %s\n", deterministic ? "yes" : "NO");
+    return deterministic ? 0 : 1;
+}
+
+// a one-screen view panning across ever wider worlds: stepping grows with
+// the bystander count, culling and drawing should not
+int benchWorld(size_t maxScreens)
+{
+    const int ticks = 300;
+    const float screenW = 900.0f;
+    std::printf("World: %d ticks, view panning %g px per tick\n", ticks, 4.0);
+    std::printf("%8s %11s %8s %8s %9s %12s %14s\n", "screens", "bystanders", "drawn", "culled", "skipped",
+                "step ms", "cull+draw ms");
+    for (size_t screens = 1; screens <= maxScreens; screens *= 4)
+    {
+        JobSystem jobs(1);
+        World world(screenW, 500.0f, static_cast<int>(screens), 7);
+        PrimitiveBatch batch;
+        std::vector<BystanderView> visible;
+        visible.reserve(world.maxVisible());
+        std::vector<Target> targets;
+        targets.reserve(world.maxVisible());
+        CullStats cull;
+        double stepMs = 0.0, drawMs = 0.0;
+        for (int t = 0; t < ticks; ++t)
+        {
+            float left = std::fmod(t * 4.0f, std::max(world.width() - screenW, 1.0f));
+            auto start = BenchClock::now();
+            world.step(jobs, left, left + screenW);
+            stepMs += elapsedMs(start);
+
+            start = BenchClock::now();
+            visible.clear();
+            world.gather(left, left + screenW, visible, cull);
+            World::draw(visible, targets, batch);
+            batch.build();
+            batch.clear();
+            drawMs += elapsedMs(start);
+        }
+        std::printf("%8zu %11zu %8.1f %8.1f %9.1f %12.4f %14.4f\n", screens, world.bystanders(),
+                    static_cast<double>(cull.drawn()) / ticks, static_cast<double>(cull.culled) / ticks,
+                    static_cast<double>(cull.skipped) / ticks, stepMs / ticks, drawMs / ticks);
+    }
+    return 0;
+}
+
+// one crowd frame rasterized on the CPU with 1, 2, 4, ... threads; the
+// image must not depend on the thread count
+int benchRaster(size_t count)
+{
+    Rng rng(5);
+    WalkerPool pool(count);
+    std::vector<Ball> balls;
+    std::vector<Target> targets;
+    for (size_t i = 0; i < count; ++i)
+    {
+        Vector2 c;
+        float r;
+        randomBallFor(rng, c, r);
+        pool.add(c, r);
+        balls.emplace_back(c, r, ORANGE);
+        targets.push_back(rounds::randomTarget(rng, 0.0f, rounds::kScreenW, rounds::kGroundY));
+    }
+    for (int f = 0; f < 120; ++f)
+        pool.stepAll();
+
+    PrimitiveBatch batch;
+    batch.setLayer(0);
+    for (size_t i = 0; i < count; ++i)
+        Walker::draw(pool.pose(i), batch);
+    batch.setLayer(1);
+    for (const Ball &b : balls)
+        b.draw(batch, b.pos);
+    batch.setLayer(2);
+    Target::drawAll(targets.data(), targets.size(), batch);
+    const PrimitiveBatch::Stats &stats = batch.build();
+
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned t = 1; t < hw; t *= 2)
+        threadCounts.push_back(t);
+    threadCounts.push_back(hw);
+
+    const int frames = 20;
+    std::printf("SoftwareRenderer (%s): %zu walkers, %d primitives, 900 x 600, %d x %d tiles\n",
+                SoftwareRenderer::simdName(), count, stats.primitives, SoftwareRenderer::kTile,
+                SoftwareRenderer::kTile);
+    std::printf("%8s %12s %9s %18s\n", "threads", "ms/frame", "speedup", "image checksum");
+    double base = 0.0;
+    uint64_t reference = 0;
+    bool deterministic = true;
+    for (unsigned threads : threadCounts)
+    {
+        JobSystem jobs(threads);
+        SoftwareRenderer image(900, 600);
+        auto start = BenchClock::now();
+        for (int f = 0; f < frames; ++f)
+        {
+            image.clear(RAYWHITE);
+            image.draw(batch, jobs);
+        }
+        double ms = elapsedMs(start) / frames;
+
+        uint64_t checksum = image.checksum();
+        if (threads == 1)
+        {
+            base = ms;
+            reference = checksum;
+        }
+        deterministic = deterministic && checksum == reference;
+        std::printf("%8u %12.3f %8.2fx %18llx\n", threads, ms, base / ms, static_cast<unsigned long long>(checksum));
+    }
+    std::printf("same image on every thread count: %s\n", deterministic ? "yes" : "NO");
+    return deterministic ? 0 : 1;
+}
+
+int runBenchMode(const char *name, long count)
+{
+    if (std::strcmp(name, "walkers") == 0)
+        return benchWalkers(count > 0 ? count : 100000);
+    if (std::strcmp(name, "ik") == 0)
+        return benchIK(count > 0 ? count : 1 << 16);
+    if (std::strcmp(name, "balls") == 0)
+        return benchBalls(count > 0 ? count : 1000000);
+    if (std::strcmp(name, "impacts") == 0)
+        return benchImpacts(count > 0 ? count : 20000);
+    if (std::strcmp(name, "batch") == 0)
+        return benchBatch(count > 0 ? count : 10000);
+    if (std::strcmp(name, "grid") == 0)
+        return benchGrid(count > 0 ? count : 10000);
+    if (std::strcmp(name, "throws") == 0)
+        return benchThrows(count > 0 ? count : 100000);
+    if (std::strcmp(name, "skeleton") == 0)
+        return benchSkeleton(count > 0 ? count : 1024);
+    if (std::strcmp(name, "entities") == 0)
+        return benchEntities(count > 0 ? count : 10000);
+    if (std::strcmp(name, "trig") == 0)
+        return benchTrig(count > 0 ? count : 200);
+    if (std::strcmp(name, "walkcycle") == 0)
+        return benchWalkCycle(count > 0 ? count : 1000);
+    if (std::strcmp(name, "jobs") == 0)
+        return benchJobs(count > 0 ? count : 20000);
+    if (std::strcmp(name, "world") == 0)
+        return benchWorld(count > 0 ? count : 256);
+    if (std::strcmp(name, "raster") == 0)
+        return benchRaster(count > 0 ? count : 200);
+    std::fprintf(stderr, "unknown benchmark '%s'\n", name);
+    return 1;
+}
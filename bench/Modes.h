@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+
+// Whole-system benchmarks with correctness checks, run by
+// `oocatcher_bench --bench <name> [count]`. Each prints a small table to
+// stdout and returns the exit code: 1 when one of its correctness checks
+// failed.
+int benchWalkers(size_t maxWalkers);
+int benchIK(size_t limbs);
+int benchBalls(size_t balls);
+int benchImpacts(size_t throws);
+int benchBatch(size_t walkers);
+int benchGrid(size_t walkers);
+int benchThrows(size_t throws);
+int benchSkeleton(size_t maxDepth);
+int benchEntities(size_t entities);
+int benchTrig(size_t walkers);
+int benchWalkCycle(size_t walkers);
+int benchJobs(size_t walkers);
+int benchWorld(size_t maxScreens);
+int benchRaster(size_t walkers);
+
+// runs the mode called `name` with `count` (0 for its default); 1 and a
+// message for an unknown name
+int runBenchMode(const char *name, long count);
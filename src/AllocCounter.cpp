@@ -0,0 +1,93 @@
+#include "AllocCounter.h"
+
+#ifdef OOCATCHER_TRACK_ALLOCS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<long> allocCount{0};
+static std::atomic<long> allocBytes{0};
+
+namespace allocs
+{
+    bool tracking() { return true; }
+    long count() { return allocCount.load(std::memory_order_relaxed); }
+    long bytes() { return allocBytes.load(std::memory_order_relaxed); }
+}
+
+static void *countedAlloc(std::size_t n)
+{
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(static_cast<long>(n), std::memory_order_relaxed);
+    return std::malloc(n ? n : 1);
+}
+
+static void *countedAlignedAlloc(std::size_t n, std::size_t align)
+{
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(static_cast<long>(n), std::memory_order_relaxed);
+#ifdef _WIN32
+    return _aligned_malloc(n ? n : 1, align);
+#else
+    void *p = nullptr;
+    return posix_memalign(&p, align < sizeof(void *) ? sizeof(void *) : align, n ? n : 1) == 0 ? p : nullptr;
+#endif
+}
+
+static void alignedFree(void *p)
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void *operator new(std::size_t n)
+{
+    if (void *p = countedAlloc(n))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t n)
+{
+    return operator new(n);
+}
+
+void *operator new(std::size_t n, const std::nothrow_t &) noexcept { return countedAlloc(n); }
+void *operator new[](std::size_t n, const std::nothrow_t &) noexcept { return countedAlloc(n); }
+
+void *operator new(std::size_t n, std::align_val_t a)
+{
+    if (void *p = countedAlignedAlloc(n, static_cast<std::size_t>(a)))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t n, std::align_val_t a)
+{
+    return operator new(n, a);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+
+#else
+
+namespace allocs
+{
+    bool tracking() { return false; }
+    long count() { return -1; }
+    long bytes() { return -1; }
+}
+
+#endif
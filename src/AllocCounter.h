@@ -0,0 +1,25 @@
+#pragma once
+
+// Counts every global operator new, for catching allocations in code that
+// should run from preallocated storage. Built with the
+// OOCATCHER_TRACK_ALLOCS CMake option the replacement operators in
+// AllocCounter.cpp are linked in; without it nothing is hooked and both
+// counters stay at -1.
+namespace allocs
+{
+    bool tracking();
+    // allocations and bytes requested since startup, on every thread
+    long count();
+    long bytes();
+
+    // allocations between construction and now
+    class Scope
+    {
+    public:
+        Scope() : start(count()) {}
+        long allocations() const { return tracking() ? count() - start : -1; }
+
+    private:
+        long start;
+    };
+}
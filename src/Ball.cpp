@@ -1,4 +1,5 @@
 #include "Ball.h"
+#include "Profiler.h"
 
 Ball::Ball(Vector2 center, float radius, Color color)
 	: pos(center), vel({0, 0}), radius(radius), color(color), state(BALL_ON_GROUND)
@@ -10,6 +11,7 @@ void Ball::hold(const Vector2 &handPos)
 	pos = handPos;
 	vel = {0, 0};
 	state = BALL_HELD;
+	predicted = false;
 }
 
 void Ball::throwTo(const Vector2 &start,
@@ -21,10 +23,44 @@ void Ball::throwTo(const Vector2 &start,
 	vel.x = (target.x - start.x) / timeToTarget;
 	vel.y = (target.y - start.y - 0.5f * gravity * timeToTarget * timeToTarget) / timeToTarget;
 	state = BALL_THROWN;
+
+	path = {start, vel, gravity};
+	flightClock = 0.0f;
+	predicted = false;
+	hitTarget = -1;
+}
+
+void Ball::predict(float groundY, const Circle *targets, size_t count)
+{
+	predicted = state == BALL_THROWN && predictImpacts(path, radius, groundY, targets, count, impacts);
+	nextImpact = 0;
 }
 
 void Ball::update(float gravity, float dt, float groundY)
 {
+	PROFILE_ZONE("Ball::update");
+	if (state == BALL_THROWN && predicted)
+	{
+		flightClock += dt;
+		for (; nextImpact < impacts.size() && impacts[nextImpact].time <= flightClock; ++nextImpact)
+		{
+			const Impact &hit = impacts[nextImpact];
+			if (hit.kind == IMPACT_TARGET)
+			{
+				hitTarget = hit.target;
+				continue;
+			}
+			pos = hit.center;
+			vel = {0, 0};
+			state = BALL_AT_REST;
+			predicted = false;
+			return;
+		}
+		pos = path.at(flightClock);
+		vel = path.velocityAt(flightClock);
+		return;
+	}
+
 	if (state == BALL_THROWN || state == BALL_FALLING)
 	{
 		vel.y += gravity * dt;
@@ -51,6 +87,16 @@ void Ball::draw() const
 	DrawCircleV(pos, radius, Fade(color, 0.25f));
 }
 
+void Ball::draw(PrimitiveBatch &batch, Vector2 at) const
+{
+	draw(batch, at, radius, color);
+}
+
+void Ball::draw(PrimitiveBatch &batch, Vector2 at, float radius, Color color)
+{
+	batch.circle(at, radius, Fade(color, 0.25f));
+}
+
 Vector2 Ball::getPos() const
 {
 	return pos;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "raylib.h"
+#include "PrimitiveBatch.h"
+#include "Ballistics.h"
 
 enum BallState
 {
@@ -18,8 +20,14 @@ public:
 
     void hold(const Vector2 &handPos);
     void throwTo(const Vector2 &start, const Vector2 &target, float gravity, float timeToTarget);
+    // Solves the current throw against the ground and targets once. A
+    // predicted ball then follows the exact parabola and update() only
+    // compares its flight clock with the next impact time.
+    void predict(float groundY, const Circle *targets, size_t count);
     void update(float gravity, float dt, float groundY);
     void draw() const;
+    void draw(PrimitiveBatch &batch, Vector2 at) const;
+    static void draw(PrimitiveBatch &batch, Vector2 at, float radius, Color color);
 
     Vector2 getPos() const;
     float getRadius() const;
@@ -31,4 +39,12 @@ public:
     float radius;
     Color color;
     BallState state;
+
+    // analytic flight, valid while predicted is set
+    Trajectory path;
+    ImpactList impacts;
+    size_t nextImpact = 0;
+    float flightClock = 0.0f;
+    bool predicted = false;
+    int hitTarget = -1; // last target index passed through, -1 if none
 };
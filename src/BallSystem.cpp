@@ -0,0 +1,142 @@
+#include "BallSystem.h"
+#include "Simd.h"
+
+BallSystem::BallSystem(size_t capacity)
+    : posX(capacity), posY(capacity), velX(capacity), velY(capacity), radius(capacity),
+      state(capacity), color(capacity)
+{
+    landed.reserve(capacity);
+}
+
+int BallSystem::spawn(Vector2 center, float r, Color c)
+{
+    if (count == posX.size())
+        return -1;
+
+    size_t i = count++;
+    respawn(i, center, r);
+    color[i] = c;
+    return static_cast<int>(i);
+}
+
+void BallSystem::respawn(size_t i, Vector2 center, float r)
+{
+    posX[i] = center.x;
+    posY[i] = center.y;
+    velX[i] = 0.0f;
+    velY[i] = 0.0f;
+    radius[i] = r;
+    state[i] = BALL_ON_GROUND;
+}
+
+void BallSystem::clear()
+{
+    count = 0;
+    landed.clear();
+}
+
+void BallSystem::hold(size_t i, const Vector2 &handPos)
+{
+    posX[i] = handPos.x;
+    posY[i] = handPos.y;
+    velX[i] = velY[i] = 0.0f;
+    state[i] = BALL_HELD;
+}
+
+void BallSystem::throwTo(size_t i, const Vector2 &start, const Vector2 &target, float gravity, float timeToTarget)
+{
+    posX[i] = start.x;
+    posY[i] = start.y;
+    velX[i] = (target.x - start.x) / timeToTarget;
+    velY[i] = (target.y - start.y - 0.5f * gravity * timeToTarget * timeToTarget) / timeToTarget;
+    state[i] = BALL_THROWN;
+}
+
+void BallSystem::update(float gravity, float dt, float groundY)
+{
+    landed.clear();
+    updateRange(0, count, gravity, dt, groundY, landed);
+}
+
+void BallSystem::updateRange(size_t begin, size_t end, float gravity, float dt, float groundY,
+                             std::vector<BallEvent> &events)
+{
+    size_t i = begin;
+
+#ifdef OOCATCHER_SIMD
+    using simd::Ops;
+    using V = Ops::V;
+
+    const V g = Ops::set1(gravity * dt), vdt = Ops::set1(dt), ground = Ops::set1(groundY), zero = Ops::set1(0.0f);
+    const Ops::I thrown = Ops::set1i(BALL_THROWN), falling = Ops::set1i(BALL_FALLING), atRest = Ops::set1i(BALL_AT_REST);
+
+    for (; i + Ops::width <= end; i += Ops::width)
+    {
+        Ops::I s = Ops::loadi(state.data() + i);
+        V isThrown = Ops::eqi(s, thrown), isFalling = Ops::eqi(s, falling);
+        V flying = Ops::orv(isThrown, isFalling);
+        if (Ops::movemask(flying) == 0)
+            continue;
+
+        V vx = Ops::load(velX.data() + i), vy = Ops::load(velY.data() + i);
+        V px = Ops::load(posX.data() + i), py = Ops::load(posY.data() + i);
+
+        vy = Ops::select(flying, Ops::add(vy, g), vy);
+        px = Ops::select(flying, Ops::add(px, Ops::mul(vx, vdt)), px);
+        py = Ops::select(flying, Ops::add(py, Ops::mul(vy, vdt)), py);
+
+        // thrown balls only land on the way down, falling ones on any contact
+        V rest = Ops::sub(ground, Ops::load(radius.data() + i));
+        V contact = Ops::andv(Ops::gt(py, rest), Ops::orv(isFalling, Ops::gt(vy, zero)));
+        contact = Ops::andv(contact, flying);
+
+        Ops::store(posX.data() + i, px);
+        Ops::store(posY.data() + i, Ops::select(contact, rest, py));
+        Ops::store(velX.data() + i, Ops::select(contact, zero, vx));
+        Ops::store(velY.data() + i, Ops::select(contact, zero, vy));
+        Ops::storei(state.data() + i, Ops::selecti(contact, atRest, s));
+
+        int hits = Ops::movemask(contact);
+        if (hits == 0)
+            continue;
+        int wasThrown = Ops::movemask(isThrown);
+        for (int lane = 0; lane < Ops::width; ++lane)
+            if (hits >> lane & 1)
+                events.push_back({static_cast<uint32_t>(i + lane),
+                                  wasThrown >> lane & 1 ? BALL_THROWN : BALL_FALLING,
+                                  BALL_AT_REST});
+    }
+#endif
+
+    updateScalar(i, end, gravity, dt, groundY, events);
+}
+
+void BallSystem::updateScalar(size_t begin, size_t end, float gravity, float dt, float groundY,
+                              std::vector<BallEvent> &events)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        BallState s = static_cast<BallState>(state[i]);
+        if (s != BALL_THROWN && s != BALL_FALLING)
+            continue;
+
+        velY[i] += gravity * dt;
+        posX[i] += velX[i] * dt;
+        posY[i] += velY[i] * dt;
+
+        float rest = groundY - radius[i];
+        if (posY[i] > rest && (s == BALL_FALLING || velY[i] > 0))
+        {
+            posY[i] = rest;
+            velX[i] = velY[i] = 0.0f;
+            state[i] = BALL_AT_REST;
+            events.push_back({static_cast<uint32_t>(i), s, BALL_AT_REST});
+        }
+    }
+}
+
+void BallSystem::draw() const
+{
+    for (size_t i = 0; i < count; ++i)
+        DrawCircleV({posX[i], posY[i]}, radius[i], Fade(color[i], 0.25f));
+}
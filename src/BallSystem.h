@@ -0,0 +1,59 @@
+#pragma once
+#include "raylib.h"
+#include "Ball.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// a ball changed state during BallSystem::update
+struct BallEvent
+{
+    uint32_t ball;
+    BallState from;
+    BallState to;
+};
+
+// Fixed-capacity struct-of-arrays store for many balls. update() integrates
+// every flying ball with the same rules as Ball::update, a SIMD lane at a
+// time, and resolves ground contact with masks instead of per-ball branches.
+class BallSystem
+{
+public:
+    explicit BallSystem(size_t capacity);
+
+    // returns the new ball's index, or -1 when the system is full
+    int spawn(Vector2 center, float radius, Color color);
+    void clear();
+    size_t size() const { return count; }
+    size_t capacity() const { return posX.size(); }
+
+    // puts ball i back on the ground at center, as spawn() does
+    void respawn(size_t i, Vector2 center, float radius);
+    void hold(size_t i, const Vector2 &handPos);
+    void throwTo(size_t i, const Vector2 &start, const Vector2 &target, float gravity, float timeToTarget);
+    void update(float gravity, float dt, float groundY);
+    // update() for balls [begin, end) only, appending their events; disjoint
+    // ranges may run on different threads
+    void updateRange(size_t begin, size_t end, float gravity, float dt, float groundY,
+                     std::vector<BallEvent> &events);
+    void draw() const;
+
+    Vector2 getPos(size_t i) const { return {posX[i], posY[i]}; }
+    Vector2 getVel(size_t i) const { return {velX[i], velY[i]}; }
+    float getRadius(size_t i) const { return radius[i]; }
+    BallState getState(size_t i) const { return static_cast<BallState>(state[i]); }
+    void setState(size_t i, BallState s) { state[i] = s; }
+
+    // state changes produced by the last update(), in ball order
+    const std::vector<BallEvent> &events() const { return landed; }
+
+private:
+    void updateScalar(size_t begin, size_t end, float gravity, float dt, float groundY,
+                      std::vector<BallEvent> &events);
+
+    size_t count = 0;
+    std::vector<float> posX, posY, velX, velY, radius;
+    std::vector<int32_t> state;
+    std::vector<Color> color;
+    std::vector<BallEvent> landed;
+};
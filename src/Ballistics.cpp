@@ -0,0 +1,160 @@
+#include "Ballistics.h"
+#include <algorithm>
+#include <cmath>
+
+Vector2 Trajectory::at(float t) const
+{
+    return {start.x + vel.x * t, start.y + vel.y * t + 0.5f * gravity * t * t};
+}
+
+Vector2 Trajectory::velocityAt(float t) const
+{
+    return {vel.x, vel.y + gravity * t};
+}
+
+float groundImpactTime(const Trajectory &path, float radius, float groundY)
+{
+    // 0.5 g t^2 + vy t + (y0 - rest) = 0, the later root is the descent
+    double g = path.gravity, vy = path.vel.y, c = path.start.y - (groundY - radius);
+    if (g == 0.0)
+        return vy > 0.0 ? static_cast<float>(-c / vy) : -1.0f;
+    double disc = vy * vy - 2.0 * g * c;
+    if (disc < 0.0)
+        return -1.0f;
+    double t = (-vy + std::sqrt(disc)) / g;
+    return t >= 0.0 ? static_cast<float>(t) : -1.0f;
+}
+
+// Real roots of a t^3 + b t^2 + c t + d, in any order. Falls back to the
+// quadratic / linear cases when the leading terms vanish.
+static int solveCubic(double a, double b, double c, double d, double roots[3])
+{
+    const double eps = 1e-12;
+    if (std::fabs(a) < eps)
+    {
+        if (std::fabs(b) < eps)
+        {
+            if (std::fabs(c) < eps)
+                return 0;
+            roots[0] = -d / c;
+            return 1;
+        }
+        double disc = c * c - 4 * b * d;
+        if (disc < 0)
+            return 0;
+        double s = std::sqrt(disc);
+        roots[0] = (-c - s) / (2 * b);
+        roots[1] = (-c + s) / (2 * b);
+        return 2;
+    }
+
+    // depressed cubic x^3 + p x + q with t = x - b / 3a (Cardano / Viete)
+    double B = b / a, C = c / a, D = d / a;
+    double p = C - B * B / 3, q = 2 * B * B * B / 27 - B * C / 3 + D;
+    double shift = -B / 3;
+    double disc = q * q / 4 + p * p * p / 27;
+    if (disc > 0)
+    {
+        double s = std::sqrt(disc);
+        roots[0] = std::cbrt(-q / 2 + s) + std::cbrt(-q / 2 - s) + shift;
+        return 1;
+    }
+    if (std::fabs(p) < eps)
+    {
+        roots[0] = shift;
+        return 1;
+    }
+    double r = 2 * std::sqrt(-p / 3);
+    double phi = std::acos(std::max(-1.0, std::min(1.0, 3 * q / (p * r))));
+    for (int k = 0; k < 3; ++k)
+        roots[k] = r * std::cos((phi - 2 * PI * k) / 3) + shift;
+    return 3;
+}
+
+bool sweepCircle(const Trajectory &path, float radius, const Circle &c, float tMax, Impact &out)
+{
+    // f(t) = |d + v t + h t^2|^2 - rho^2 with h = (0, g / 2) is a quartic;
+    // its derivative's roots split [0, tMax] into monotone pieces, and the
+    // first piece that changes sign holds the first contact
+    double dx = path.start.x - c.x, dy = path.start.y - c.y;
+    double vx = path.vel.x, vy = path.vel.y, h = 0.5 * path.gravity;
+    double rho = static_cast<double>(radius) + c.radius;
+
+    double k4 = h * h;
+    double k3 = 2 * h * vy;
+    double k2 = vx * vx + vy * vy + 2 * h * dy;
+    double k1 = 2 * (vx * dx + vy * dy);
+    double k0 = dx * dx + dy * dy - rho * rho;
+    auto f = [&](double t)
+    { return (((k4 * t + k3) * t + k2) * t + k1) * t + k0; };
+
+    double split[5];
+    int n = 0;
+    split[n++] = 0.0;
+    double crit[3];
+    int nc = solveCubic(4 * k4, 3 * k3, 2 * k2, k1, crit);
+    std::sort(crit, crit + nc);
+    for (int i = 0; i < nc; ++i)
+        if (crit[i] > 0.0 && crit[i] < tMax)
+            split[n++] = crit[i];
+    split[n++] = tMax;
+
+    double hit = -1.0;
+    if (f(0.0) <= 0.0)
+        hit = 0.0;
+    for (int i = 0; i + 1 < n && hit < 0.0; ++i)
+    {
+        double lo = split[i], hi = split[i + 1];
+        if (f(lo) <= 0.0 || f(hi) > 0.0)
+            continue;
+        for (int it = 0; it < 60; ++it)
+        {
+            double mid = 0.5 * (lo + hi);
+            (f(mid) > 0.0 ? lo : hi) = mid;
+        }
+        hit = hi;
+    }
+    if (hit < 0.0)
+        return false;
+
+    out.kind = IMPACT_TARGET;
+    out.time = static_cast<float>(hit);
+    out.center = path.at(out.time);
+    float ux = out.center.x - c.x, uy = out.center.y - c.y;
+    float len = sqrtf(ux * ux + uy * uy);
+    float s = len > 0.0f ? c.radius / len : 0.0f;
+    out.contact = {c.x + ux * s, c.y + uy * s};
+    out.target = -1;
+    return true;
+}
+
+bool predictImpacts(const Trajectory &path, float radius, float groundY,
+                    const Circle *targets, size_t count, ImpactList &out)
+{
+    out.clear();
+    float land = groundImpactTime(path, radius, groundY);
+    if (land < 0.0f)
+        return false;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        Impact hit;
+        if (sweepCircle(path, radius, targets[i], land, hit))
+        {
+            hit.target = static_cast<int>(i);
+            out.push_back(hit);
+        }
+    }
+    std::sort(out.begin(), out.end(), [](const Impact &a, const Impact &b)
+              { return a.time < b.time; });
+
+    Impact ground;
+    ground.kind = IMPACT_GROUND;
+    ground.time = land;
+    ground.center = path.at(land);
+    ground.center.y = groundY - radius;
+    ground.contact = {ground.center.x, groundY};
+    ground.target = -1;
+    out.push_back(ground);
+    return true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "raylib.h"
+#include "Shapes.h"
+#include "SmallVector.h"
+#include <cstddef>
+
+// Closed-form ballistic path of a thrown ball: p(t) = start + vel t + g t^2 / 2,
+// with gravity pulling towards +y. Impacts are solved exactly on this
+// curve, so they do not depend on the frame rate.
+struct Trajectory
+{
+    Vector2 start;
+    Vector2 vel;
+    float gravity;
+
+    Vector2 at(float t) const;
+    Vector2 velocityAt(float t) const;
+};
+
+enum ImpactKind
+{
+    IMPACT_GROUND,
+    IMPACT_TARGET
+};
+
+struct Impact
+{
+    ImpactKind kind;
+    float time;      // seconds after release
+    Vector2 center;  // ball center at contact
+    Vector2 contact; // touching point on the surface that was hit
+    int target;      // index into the target list for IMPACT_TARGET
+};
+
+// a ball's impacts; one target and the ground stay inline
+using ImpactList = SmallVector<Impact, 4>;
+
+// First time the ball (radius r) comes down onto groundY; negative if never.
+float groundImpactTime(const Trajectory &path, float radius, float groundY);
+
+// First contact between the swept ball and circle c within [0, tMax].
+bool sweepCircle(const Trajectory &path, float radius, const Circle &c, float tMax, Impact &out);
+
+// Every target touched before the ball lands, then the landing itself,
+// in time order. Returns false if the ball never reaches the ground.
+bool predictImpacts(const Trajectory &path, float radius, float groundY,
+                    const Circle *targets, size_t count, ImpactList &out);
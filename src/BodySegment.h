@@ -1,34 +1,14 @@
 #pragma once
 #include "raylib.h"
 
+// One bone of a Skeleton. Segments live in the skeleton's array and refer
+// to their parent by index, so a skeleton copies like a plain value.
 struct BodySegment
 {
     Vector2 start, end;
     float length;
-    float angle; // in degrees
+    float angle; // in degrees, relative to the parent's direction (to +x for roots)
     float minAngle, maxAngle;
-    BodySegment *parent;
-
-    BodySegment(float len, float minA, float maxA, BodySegment *p = nullptr)
-        : length(len), minAngle(minA), maxAngle(maxA), parent(p)
-    {
-        angle = 0;
-        start = {0, 0};
-        end = {0, -len};
-    }
-
-    void update()
-    {
-        if (parent)
-            start = parent->end;
-        float rad = DEG2RAD * angle;
-        end = {
-            start.x + cosf(rad) * length,
-            start.y + sinf(rad) * length};
-    }
-
-    void draw() const
-    {
-        DrawLineV(start, end, DARKBLUE);
-    }
+    float worldAngle; // in degrees, filled in by Skeleton::solve
+    int parent;       // index of the parent segment, -1 for a root
 };
@@ -0,0 +1,214 @@
+#include "CrowdScene.h"
+#include "Profiler.h"
+#include "Rng.h"
+#include "Round.h"
+#include "StateHash.h"
+#include <algorithm>
+#include <cmath>
+
+static constexpr float kTickDt = 1.0f / rounds::kTickRate;
+static constexpr int kStandFrames = 30; // stand this long before throwing
+
+namespace
+{
+    ThrowConstraints crowdThrowLimits()
+    {
+        ThrowConstraints c;
+        c.gravity = rounds::kGravity;
+        return c;
+    }
+}
+
+CrowdScene::CrowdScene(size_t count, uint32_t seed)
+    : seed(seed), ballSystem(count), targets(count), rounds(count), detail(count, LOD_FULL), solver(crowdThrowLimits())
+{
+    crowd.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        crowd.add<Walker>(Vector2{0.0f, 0.0f}, 1.0f);
+        ballSystem.spawn({0.0f, 0.0f}, 1.0f, ORANGE);
+        startRound(i);
+    }
+    chunks.resize((count + kChunk - 1) / kChunk);
+    for (ChunkResult &c : chunks)
+        c.events.reserve(kChunk); // at most one per ball and tick, so stepping never allocates
+    buildGraph();
+}
+
+// new ball, walker and target for walker i, laid out like Game's rounds
+void CrowdScene::startRound(size_t i)
+{
+    Round &r = rounds[i];
+    // one generator per (seed, walker, round), so any round can be redrawn alone
+    Rng rng((static_cast<uint64_t>(seed) << 40) ^ (static_cast<uint64_t>(i) << 20) ^ r.number);
+    Ball ball = rounds::randomBall(rng, rounds::kStartX, rounds::kScreenW, rounds::kGroundY);
+    targets[i] = rounds::randomTarget(rng, 0.0f, rounds::kScreenW, rounds::kGroundY).bounds();
+
+    Vector2 center = ball.getPos();
+    float radius = ball.getRadius();
+    ballSystem.respawn(i, center, radius);
+    Walker &w = walkers()[i];
+    w = Walker(center, radius);
+    w.init(rounds::kStartX, kTickDt);
+
+    uint32_t number = r.number + 1;
+    r = Round();
+    r.number = number;
+}
+
+void CrowdScene::stepWalkers(size_t begin, size_t end)
+{
+    ChunkResult &out = chunks[begin / kChunk];
+    const long maxFrames = rounds::maxTicks(kTickDt); // give up on a ball out of reach
+    for (size_t i = begin; i < end; ++i)
+    {
+        Round &r = rounds[i];
+        Walker &w = walkers()[i];
+        if (r.phase == ROUND_DONE || ++r.frames > maxFrames)
+        {
+            startRound(i);
+            ++out.resets;
+        }
+
+        LodTier tier = detail[i];
+        bool touching = tier == LOD_FULL ? w.fingersTouchingBall() : w.handTouchingBall();
+        if (r.phase == ROUND_WALK && touching)
+        {
+            r.phase = ROUND_HOLD;
+            r.frames = 0;
+            w.setStandUp(true);
+        }
+        else if (r.phase == ROUND_HOLD && r.frames >= kStandFrames)
+        {
+            r.phase = ROUND_THROW;
+            r.throwTime = 0.0f;
+        }
+        if (r.phase == ROUND_THROW)
+        {
+            r.throwTime += kTickDt;
+            w.setThrowAnim(1.0f, std::min(r.throwTime / rounds::kThrowAnimDuration, 1.0f));
+        }
+        // coarse tiers catch up several ticks at once, staggered by walker
+        int every = lod.updateInterval[tier];
+        if (every <= 1)
+            w.advance(1, tier);
+        else if ((totals.ticks + static_cast<long>(i)) % every == 0)
+            w.advance(every, tier);
+    }
+}
+
+// balls follow their hands; a finished throw animation releases the ball
+void CrowdScene::holdBalls(size_t begin, size_t end)
+{
+    ChunkResult &out = chunks[begin / kChunk];
+    for (size_t i = begin; i < end; ++i)
+    {
+        Round &r = rounds[i];
+        if (r.phase != ROUND_HOLD && r.phase != ROUND_THROW)
+            continue;
+
+        Walker &w = walkers()[i];
+        Vector2 hand = w.getHandPos();
+        if (r.phase == ROUND_THROW && r.throwTime >= rounds::kThrowAnimDuration)
+        {
+            Vector2 aim = {targets[i].x, targets[i].y};
+            ThrowSolution shot = solver.solve(hand, aim);
+            ballSystem.throwTo(i, hand, aim, rounds::kGravity, shot.feasible ? shot.time : rounds::kFlightTime);
+            w.setThrowAnim(0.0f, 0.0f);
+            r.phase = ROUND_FLIGHT;
+            ++out.throws;
+        }
+        else
+            ballSystem.hold(i, hand);
+    }
+}
+
+void CrowdScene::integrate(size_t begin, size_t end)
+{
+    ballSystem.updateRange(begin, end, rounds::kGravity, kTickDt, rounds::kGroundY, chunks[begin / kChunk].events);
+}
+
+void CrowdScene::collide(size_t begin, size_t end)
+{
+    ChunkResult &out = chunks[begin / kChunk];
+    for (size_t i = begin; i < end; ++i)
+    {
+        Round &r = rounds[i];
+        if (r.phase != ROUND_FLIGHT || r.hit)
+            continue;
+        Vector2 p = ballSystem.getPos(i);
+        float dx = p.x - targets[i].x, dy = p.y - targets[i].y;
+        float reach = ballSystem.getRadius(i) + targets[i].radius;
+        if (dx * dx + dy * dy <= reach * reach)
+        {
+            r.hit = true;
+            ++out.hits;
+        }
+    }
+}
+
+void CrowdScene::resolve()
+{
+    for (ChunkResult &c : chunks)
+    {
+        for (const BallEvent &e : c.events)
+            if (rounds[e.ball].phase == ROUND_FLIGHT)
+                rounds[e.ball].phase = ROUND_DONE;
+        totals.throws += c.throws;
+        totals.hits += c.hits;
+        totals.resets += c.resets;
+        c.events.clear();
+        c.throws = c.hits = c.resets = 0;
+    }
+    ++totals.ticks;
+}
+
+void CrowdScene::buildGraph()
+{
+    auto stage = [this](const char *name, void (CrowdScene::*fn)(size_t, size_t))
+    {
+        return [this, name, fn]
+        { jobs->parallelFor(size(), kChunk, [this, name, fn](size_t b, size_t e)
+                            { PROFILE_ZONE(name); (this->*fn)(b, e); }); };
+    };
+    TaskGraph::TaskId walk = graph.add(stage("crowd.walkers", &CrowdScene::stepWalkers));
+    TaskGraph::TaskId hold = graph.add(stage("crowd.hold", &CrowdScene::holdBalls), {walk});
+    TaskGraph::TaskId fly = graph.add(stage("crowd.integrate", &CrowdScene::integrate), {hold});
+    TaskGraph::TaskId hit = graph.add(stage("crowd.collide", &CrowdScene::collide), {fly});
+    graph.add([this]
+              { PROFILE_ZONE("crowd.resolve"); resolve(); },
+              {hit});
+}
+
+void CrowdScene::step(JobSystem &jobSystem)
+{
+    PROFILE_ZONE("CrowdScene::step");
+    jobs = &jobSystem;
+    graph.run(jobSystem);
+    jobs = nullptr;
+}
+
+uint64_t CrowdScene::stateHash() const
+{
+    StateHash h;
+    for (size_t i = 0; i < size(); ++i)
+    {
+        WalkerPose p = walker(i).getPose();
+        h.add(p.torsoBottom);
+        h.add(p.torsoTop);
+        for (const Limb2 *l : {&p.leftLeg, &p.rightLeg, &p.leftArm, &p.rightArm})
+        {
+            h.add(l->joint);
+            h.add(l->tip);
+        }
+        for (const Finger2 &f : p.fingers)
+            h.add(f.tip);
+        h.add(ballSystem.getPos(i));
+        h.add(ballSystem.getVel(i));
+        h.add(static_cast<int32_t>(ballSystem.getState(i)));
+        h.add(rounds[i].phase);
+        h.add(rounds[i].number);
+    }
+    h.add(totals);
+    return h.value;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "raylib.h"
+#include "BallSystem.h"
+#include "EntityStore.h"
+#include "JobSystem.h"
+#include "Lod.h"
+#include "Shapes.h"
+#include "ThrowSolver.h"
+#include "Walker.h"
+#include <cstdint>
+#include <vector>
+
+struct CrowdStats
+{
+    long ticks = 0;
+    long throws = 0;
+    long hits = 0;
+    long resets = 0;
+};
+
+// Headless crowd: every walker plays its own round of the game (walk to its
+// ball, grab it, stand, throw at its target) on a fixed tick.
+//
+// A tick is a TaskGraph run on a JobSystem:
+//
+//   walkers -> held balls -> integrate -> collide -> resolve
+//
+// Each stage but the last is a parallelFor over fixed-size chunks that
+// only touches its own walkers and balls; per-chunk events and hit counts
+// are merged in chunk order by `resolve`. Random draws come from a hash of
+// (seed, walker, round), so the state after any number of ticks is the same
+// for every thread count.
+class CrowdScene
+{
+public:
+    static constexpr size_t kChunk = 64;
+
+    CrowdScene(size_t walkers, uint32_t seed = 1);
+
+    void step(JobSystem &jobs);
+
+    size_t size() const { return walkers().size(); }
+    const Walker &walker(size_t i) const { return walkers()[i]; }
+    const BallSystem &balls() const { return ballSystem; }
+    const Circle &target(size_t i) const { return targets[i]; }
+    bool targetActive(size_t i) const { return rounds[i].phase >= ROUND_HOLD; }
+    const CrowdStats &stats() const { return totals; }
+
+    // level of detail per walker (see Lod.h); every walker starts at LOD_FULL
+    void setDetail(size_t i, LodTier tier) { detail[i] = tier; }
+    LodTier detailOf(size_t i) const { return detail[i]; }
+    void setLodPolicy(const LodPolicy &policy) { lod = policy; }
+
+    // FNV-1a over every walker pose, ball and round state
+    uint64_t stateHash() const;
+
+private:
+    enum RoundPhase : uint8_t
+    {
+        ROUND_WALK,
+        ROUND_HOLD,
+        ROUND_THROW,
+        ROUND_FLIGHT,
+        ROUND_DONE
+    };
+
+    struct Round
+    {
+        RoundPhase phase = ROUND_WALK;
+        bool hit = false;
+        int frames = 0;
+        float throwTime = 0.0f;
+        uint32_t number = 0; // rounds this walker has started
+    };
+
+    std::vector<Walker> &walkers() { return crowd.of<Walker>(); }
+    const std::vector<Walker> &walkers() const { return crowd.of<Walker>(); }
+
+    void startRound(size_t i);
+    void stepWalkers(size_t begin, size_t end);
+    void holdBalls(size_t begin, size_t end);
+    void integrate(size_t begin, size_t end);
+    void collide(size_t begin, size_t end);
+    void resolve();
+    void buildGraph();
+
+    uint32_t seed;
+    EntityStore<Walker> crowd;
+    BallSystem ballSystem;
+    std::vector<Circle> targets;
+    std::vector<Round> rounds;
+    std::vector<LodTier> detail;
+    LodPolicy lod;
+    ThrowSolver solver;
+
+    // what each chunk produced during the current tick, merged in chunk order
+    struct ChunkResult
+    {
+        std::vector<BallEvent> events;
+        int throws = 0, hits = 0, resets = 0;
+    };
+    std::vector<ChunkResult> chunks;
+
+    CrowdStats totals;
+    TaskGraph graph;
+    JobSystem *jobs = nullptr; // valid during step()
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include "PrimitiveBatch.h"
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// One contiguous array per catcher kind, dispatched at compile time.
+//
+// Each Kinds... is an OOCatcher<Kind>. stepAll() and drawAll() expand to
+// one plain loop per kind, so step() and draw() can inline and there is
+// no per-entity allocation. Adding a kind is adding it to the list:
+//     EntityStore<Walker, Juggler> crowd;
+template <class... Kinds>
+class EntityStore
+{
+public:
+    template <class Kind, class... Args>
+    size_t add(Args &&...args)
+    {
+        std::vector<Kind> &v = of<Kind>();
+        v.emplace_back(std::forward<Args>(args)...);
+        v.back().init();
+        return v.size() - 1;
+    }
+
+    template <class Kind>
+    std::vector<Kind> &of() { return std::get<std::vector<Kind>>(kinds); }
+    template <class Kind>
+    const std::vector<Kind> &of() const { return std::get<std::vector<Kind>>(kinds); }
+
+    template <class Kind>
+    Kind &get(size_t i) { return of<Kind>()[i]; }
+
+    // calls f(entity) for every entity, kind by kind
+    template <class F>
+    void forEach(F &&f)
+    {
+        std::apply([&f](auto &...v)
+                   { (forEachIn(v, f), ...); },
+                   kinds);
+    }
+    template <class F>
+    void forEach(F &&f) const
+    {
+        std::apply([&f](const auto &...v)
+                   { (forEachIn(v, f), ...); },
+                   kinds);
+    }
+
+    void stepAll()
+    {
+        forEach([](auto &e)
+                { e.step(); });
+    }
+    void drawAll(PrimitiveBatch &batch) const
+    {
+        forEach([&batch](const auto &e)
+                { e.draw(batch); });
+    }
+
+    size_t size() const
+    {
+        return std::apply([](const auto &...v)
+                          { return (size_t(0) + ... + v.size()); },
+                          kinds);
+    }
+    void clear()
+    {
+        std::apply([](auto &...v)
+                   { (v.clear(), ...); },
+                   kinds);
+    }
+    void reserve(size_t perKind)
+    {
+        std::apply([perKind](auto &...v)
+                   { (v.reserve(perKind), ...); },
+                   kinds);
+    }
+
+private:
+    template <class V, class F>
+    static void forEachIn(V &v, F &f)
+    {
+        for (auto &e : v)
+            f(e);
+    }
+
+    std::tuple<std::vector<Kinds>...> kinds;
+};
@@ -0,0 +1,223 @@
+#pragma once
+#include "raylib.h"
+#include "Simd.h"
+#include <cmath>
+
+// Trig for the animation code, with the precision picked at build time by
+// the OOCATCHER_TRIG CMake option:
+//
+//   libm   sinf/cosf/acosf/atan2f (default)
+//   poly   polynomial sin/cos, acos and atan2, within ~5e-6
+//   table  sin/cos from a compile-time table with linear interpolation,
+//          polynomial acos/atan2; ~3e-7 near zero, growing with |x| as the
+//          float phase loses bits (~1.5e-5 at the walker's phase range)
+//
+// `--bench trig` reports the error of each version against libm on the
+// walker's own inputs.
+//
+// trig::sin/cos/acos/atan2 are the selected versions. The table and
+// polynomial versions are always available under their own names, and the
+// SIMD ones (sinv, cosv, acosv, atan2v) whenever OOCATCHER_SIMD is.
+namespace trig
+{
+    // ---- compile-time sin table over one turn ----
+
+    constexpr int kTableBits = 12;
+    constexpr int kTableSize = 1 << kTableBits;
+
+    struct SinTable
+    {
+        float v[kTableSize + 1]; // v[kTableSize] == v[0] so lookups never wrap
+    };
+
+    constexpr double taylorSin(double x)
+    {
+        // x in [-pi, pi]; enough terms that double rounding dominates
+        double term = x, sum = x;
+        for (int n = 1; n < 14; ++n)
+        {
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        return sum;
+    }
+
+    constexpr SinTable makeSinTable()
+    {
+        SinTable t{};
+        const double pi = 3.14159265358979323846;
+        for (int i = 0; i <= kTableSize; ++i)
+        {
+            double x = 2 * pi * i / kTableSize;
+            t.v[i] = static_cast<float>(taylorSin(x > pi ? x - 2 * pi : x));
+        }
+        return t;
+    }
+
+    inline constexpr SinTable kSinTable = makeSinTable();
+
+    inline float tableSin(float x)
+    {
+        float u = x * (kTableSize / (2 * PI));
+        float fl = floorf(u);
+        int i = static_cast<int>(fl) & (kTableSize - 1);
+        float f = u - fl;
+        return kSinTable.v[i] + (kSinTable.v[i + 1] - kSinTable.v[i]) * f;
+    }
+
+    inline float tableCos(float x)
+    {
+        return tableSin(x + PI / 2);
+    }
+
+    // ---- polynomials ----
+
+    // sin(x): reduce by multiples of pi to [-pi/2, pi/2], odd polynomial to x^11
+    inline float polySin(float x)
+    {
+        float q = x * (1.0f / PI);
+        int k = static_cast<int>(q + (q >= 0.0f ? 0.5f : -0.5f));
+        float r = (x - k * 3.140625f) - k * 9.67653589793e-4f;
+        float r2 = r * r;
+        float p = -2.5052108e-8f;
+        p = p * r2 + 2.7557319e-6f;
+        p = p * r2 - 1.9841270e-4f;
+        p = p * r2 + 8.3333333e-3f;
+        p = p * r2 - 1.6666667e-1f;
+        float s = r + p * r2 * r;
+        return (k & 1) ? -s : s;
+    }
+
+    inline float polyCos(float x)
+    {
+        return polySin(x + PI / 2);
+    }
+
+    // acos(x) for x in [-1, 1] (Abramowitz & Stegun 4.4.46, |err| < 2e-8)
+    inline float polyAcos(float x)
+    {
+        float ax = fabsf(x);
+        float p = -0.0012624911f;
+        p = p * ax + 0.0066700901f;
+        p = p * ax - 0.0170881256f;
+        p = p * ax + 0.0308918810f;
+        p = p * ax - 0.0501743046f;
+        p = p * ax + 0.0889789874f;
+        p = p * ax - 0.2145988016f;
+        p = p * ax + 1.5707963050f;
+        float r = p * sqrtf(1.0f - ax);
+        return x < 0.0f ? PI - r : r;
+    }
+
+    // atan2(y, x) via a minimax atan on [0, 1] and octant fix-ups
+    inline float polyAtan2(float y, float x)
+    {
+        float ay = fabsf(y), ax = fabsf(x);
+        float hi = fmaxf(ax, ay), lo = fminf(ax, ay);
+        float z = lo / fmaxf(hi, 1e-30f);
+        float z2 = z * z;
+        float p = -0.0117212f;
+        p = p * z2 + 0.05265332f;
+        p = p * z2 - 0.11643287f;
+        p = p * z2 + 0.19354346f;
+        p = p * z2 - 0.33262347f;
+        p = p * z2 + 0.99997726f;
+        float r = p * z;
+        if (ax < ay)
+            r = PI / 2 - r;
+        if (x < 0.0f)
+            r = PI - r;
+        return copysignf(r, y);
+    }
+
+    // ---- selected by OOCATCHER_TRIG ----
+
+#if defined(OOCATCHER_TRIG_TABLE)
+    inline float sin(float x) { return tableSin(x); }
+    inline float cos(float x) { return tableCos(x); }
+    inline float acos(float x) { return polyAcos(x); }
+    inline float atan2(float y, float x) { return polyAtan2(y, x); }
+    constexpr const char *backendName = "table";
+#elif defined(OOCATCHER_TRIG_POLY)
+    inline float sin(float x) { return polySin(x); }
+    inline float cos(float x) { return polyCos(x); }
+    inline float acos(float x) { return polyAcos(x); }
+    inline float atan2(float y, float x) { return polyAtan2(y, x); }
+    constexpr const char *backendName = "poly";
+#else
+    inline float sin(float x) { return sinf(x); }
+    inline float cos(float x) { return cosf(x); }
+    inline float acos(float x) { return acosf(x); }
+    inline float atan2(float y, float x) { return atan2f(y, x); }
+    constexpr const char *backendName = "libm";
+#endif
+
+#ifdef OOCATCHER_SIMD
+    // ---- SIMD versions of the polynomials, one lane per element ----
+
+    using V = simd::Ops::V;
+
+    inline V signMask() { return simd::Ops::set1(-0.0f); }
+
+    inline V fabsv(V a)
+    {
+        return simd::Ops::andnot(signMask(), a);
+    }
+
+    inline V sinv(V x)
+    {
+        using simd::Ops;
+        Ops::I k = Ops::toInt(Ops::mul(x, Ops::set1(1.0f / PI)));
+        V kf = Ops::toFloat(k);
+        V r = Ops::sub(Ops::sub(x, Ops::mul(kf, Ops::set1(3.140625f))), Ops::mul(kf, Ops::set1(9.67653589793e-4f)));
+        V r2 = Ops::mul(r, r);
+        V p = Ops::set1(-2.5052108e-8f);
+        p = Ops::add(Ops::mul(p, r2), Ops::set1(2.7557319e-6f));
+        p = Ops::add(Ops::mul(p, r2), Ops::set1(-1.9841270e-4f));
+        p = Ops::add(Ops::mul(p, r2), Ops::set1(8.3333333e-3f));
+        p = Ops::add(Ops::mul(p, r2), Ops::set1(-1.6666667e-1f));
+        V s = Ops::add(r, Ops::mul(Ops::mul(p, r2), r));
+        return Ops::xorv(s, Ops::oddSign(k));
+    }
+
+    inline V cosv(V x)
+    {
+        return sinv(simd::Ops::add(x, simd::Ops::set1(PI / 2)));
+    }
+
+    inline V acosv(V x)
+    {
+        using simd::Ops;
+        V ax = fabsv(x);
+        V p = Ops::set1(-0.0012624911f);
+        p = Ops::add(Ops::mul(p, ax), Ops::set1(0.0066700901f));
+        p = Ops::add(Ops::mul(p, ax), Ops::set1(-0.0170881256f));
+        p = Ops::add(Ops::mul(p, ax), Ops::set1(0.0308918810f));
+        p = Ops::add(Ops::mul(p, ax), Ops::set1(-0.0501743046f));
+        p = Ops::add(Ops::mul(p, ax), Ops::set1(0.0889789874f));
+        p = Ops::add(Ops::mul(p, ax), Ops::set1(-0.2145988016f));
+        p = Ops::add(Ops::mul(p, ax), Ops::set1(1.5707963050f));
+        V r = Ops::mul(p, Ops::sqrt(Ops::sub(Ops::set1(1.0f), ax)));
+        return Ops::select(Ops::lt(x, Ops::set1(0.0f)), Ops::sub(Ops::set1(PI), r), r);
+    }
+
+    inline V atan2v(V y, V x)
+    {
+        using simd::Ops;
+        V ay = fabsv(y), ax = fabsv(x);
+        V hi = Ops::max(ax, ay), lo = Ops::min(ax, ay);
+        V z = Ops::div(lo, Ops::max(hi, Ops::set1(1e-30f)));
+        V z2 = Ops::mul(z, z);
+        V p = Ops::set1(-0.0117212f);
+        p = Ops::add(Ops::mul(p, z2), Ops::set1(0.05265332f));
+        p = Ops::add(Ops::mul(p, z2), Ops::set1(-0.11643287f));
+        p = Ops::add(Ops::mul(p, z2), Ops::set1(0.19354346f));
+        p = Ops::add(Ops::mul(p, z2), Ops::set1(-0.33262347f));
+        p = Ops::add(Ops::mul(p, z2), Ops::set1(0.99997726f));
+        V r = Ops::mul(p, z);
+        r = Ops::select(Ops::lt(ax, ay), Ops::sub(Ops::set1(PI / 2), r), r);
+        r = Ops::select(Ops::lt(x, Ops::set1(0.0f)), Ops::sub(Ops::set1(PI), r), r);
+        return Ops::xorv(r, Ops::andv(y, signMask()));
+    }
+#endif
+}
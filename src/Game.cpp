@@ -1,51 +1,445 @@
 #include "Game.h"
-#include <cstdlib>
+#include "Profiler.h"
+#include "AllocCounter.h"
+#include "StateHash.h"
 #include <ctime>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
 
-Game::Game(int w, int h)
+static constexpr float kCameraFollow = 0.1f; // share of the gap to the walker closed per tick
+static constexpr float kCameraMaxStep = 40.0f; // px per tick, when the walker jumps back to the start
+static constexpr float kCullMargin = 32.0f;  // px past the view that still counts as visible
+
+static ThrowConstraints throwLimits(float gravity) {
+    ThrowConstraints c;
+    c.gravity = gravity;
+    return c;
+}
+
+Game::Game(int w, int h, bool headless, uint64_t seed, int worldScreens)
     : screenW(w)
     , screenH(h)
-    , groundY(500.0f)
-    , possibleColors{ RED, ORANGE, VIOLET, GREEN, BLUE, GOLD, DARKPURPLE, PINK, BROWN }
+    , headless(headless)
+    , groundY(rounds::kGroundY)
+    , worldW(static_cast<float>(w * std::max(worldScreens, 1)))
+    , sessionSeed(seed)
+    , rng(seed)
     , ball(randomBall())
     , walker(ball.getPos(), ball.getRadius())
     , target({0,0}, 0, WHITE)
+    , world(static_cast<float>(w), groundY, worldScreens, static_cast<uint32_t>(splitmix64(seed)))
 
-    , flightTime(0.9f)
-    , gravity(750.0f)
-    , throwAnimDuration(0.4f)
+    , flightTime(rounds::kFlightTime)
+    , gravity(rounds::kGravity)
+    , throwAnimDuration(rounds::kThrowAnimDuration)
     , throwAnimTime(0.0f)
+    , throwSolver(throwLimits(gravity))
 {
-    initWindow();
+    bystanderTargets.reserve(world.maxVisible());
+    if (!headless)
+        initWindow();
     initGame();
 }
 
 Game::~Game() {
-    CloseWindow();
+    if (!headless) {
+        UnloadRenderTexture(sceneCache);
+        CloseWindow();
+    }
 }
 
 void Game::initWindow() {
     InitWindow(screenW, screenH, "OOCatcher");
-    SetTargetFPS(60);
+    SetTargetFPS(renderFps);
+    sceneCache = LoadRenderTexture(screenW, screenH);
 }
 
 void Game::initGame() {
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
-    walker.init();
+    walker.init(roundStart);
+    cameraX = prevCameraX = cameraGoal();
+}
+
+// centered on the walker, but never showing past either end of the world
+float Game::cameraGoal() const {
+    float half = screenW * 0.5f;
+    return std::min(std::max(walker.getPose().torsoBottom.x, half), worldW - half);
+}
+
+uint64_t Game::timeSeed() {
+    return splitmix64(static_cast<uint64_t>(std::time(nullptr))
+                      ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+}
+
+uint64_t Game::stateHash() const {
+    StateHash h;
+    WalkerPose p = walker.getPose();
+    h.add(p.torsoBottom);
+    h.add(p.torsoTop);
+    for (const Limb2 *l : {&p.leftLeg, &p.rightLeg, &p.leftArm, &p.rightArm}) {
+        h.add(l->joint);
+        h.add(l->tip);
+    }
+    for (const Finger2 &f : p.fingers)
+        h.add(f.tip);
+    h.add(ball.pos);
+    h.add(ball.vel);
+    h.add(ball.getRadius());
+    h.add(static_cast<int32_t>(ball.state));
+    h.add(target.pos);
+    h.add(target.radius);
+    bool flags[] = { targetActive, stickmanStand, ballTouched, ballFlying, throwAnimating, targetHit };
+    h.add(flags);
+    h.add(throwAnimTime);
+    h.add(tickCount);
+    h.add(rng.state()[0]);
+    h.add(rng.state()[1]);
+    h.add(rng.state()[2]);
+    h.add(rng.state()[3]);
+    if (world.regions() > 1) {
+        h.add(cameraX);
+        h.add(roundStart);
+        h.add(world.stateHash());
+    }
+    return h.value;
+}
+
+void Game::setRecordFile(const std::string &path) {
+    recordFile = path;
+}
+
+void Game::beginSession(float tickDt) {
+    sessionDt = tickDt;
+    walker.setTickDt(tickDt);
+    if (!recordFile.empty())
+        recording.begin(sessionSeed, tickDt, world.regions());
+}
+
+// writes whatever was asked for on the command line
+void Game::endSession() {
+    if (!traceFile.empty())
+        writeTrace(traceFile);
+    if (recordFile.empty())
+        return;
+    recording.finish(tickCount, stateHash());
+    if (recording.save(recordFile.c_str()))
+        std::printf("recorded %ld ticks (%zu inputs) to %s, state hash %016llx\n", recording.ticks(),
+                    recording.inputCount(), recordFile.c_str(), static_cast<unsigned long long>(recording.finalHash()));
+    else
+        std::fprintf(stderr, "could not write %s\n", recordFile.c_str());
+}
+
+void Game::setTickRate(float hz) {
+    tickRate = std::max(hz, 1.0f);
+}
+
+void Game::setMaxSubsteps(int steps) {
+    maxSubsteps = std::max(steps, 1);
+}
+
+void Game::setRenderFps(int fps) {
+    renderFps = std::max(fps, 0);
+    if (!headless)
+        SetTargetFPS(renderFps);
+}
+
+void Game::setThreaded(bool value) {
+    threaded = value;
+}
+
+void Game::setTraceFile(const std::string &path) {
+    traceFile = path;
+    profiler::setEnabled(!traceFile.empty() || showProfiler);
+}
+
+void Game::writeTrace(const std::string &path) const {
+    size_t dot = path.rfind('.');
+    bool json = dot != std::string::npos && path.compare(dot, std::string::npos, ".json") == 0;
+    bool ok = json ? profiler::writeChromeTrace(path.c_str()) : profiler::writeCsv(path.c_str());
+    if (ok)
+        std::printf("profile written to %s\n", path.c_str());
+    else
+        std::fprintf(stderr, "could not write %s\n", path.c_str());
+}
+
+// F1 batch/snapshot counters, F2 profiler overlay, F3 dump the profile
+void Game::debugKeys() {
+    if (IsKeyPressed(KEY_F1))
+        showBatchStats = !showBatchStats;
+    if (IsKeyPressed(KEY_F2)) {
+        showProfiler = !showProfiler;
+        profiler::setEnabled(!traceFile.empty() || showProfiler);
+    }
+    if (IsKeyPressed(KEY_F3)) {
+        writeTrace("oocatcher_trace.json");
+        writeTrace("oocatcher_trace.csv");
+    }
 }
 
+double Game::clockSeconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - clockStart).count();
+}
+
+// Simulation advances in fixed ticks of 1/tickRate no matter how fast we
+// render; draw() blends the last two ticks by the leftover fraction.
 void Game::run() {
+    if (threaded) {
+        runThreaded();
+        return;
+    }
+
+    const float tickDt = 1.0f / tickRate;
+    float accumulator = tickDt; // tick once before the first draw
+    FrameInput pending;
+    PROFILE_THREAD("main");
+    beginSession(tickDt);
+
     while (!WindowShouldClose()) {
-        float dt = GetFrameTime();
-        processInput();
+        allocs::Scope frameAllocs;
+        accumulator += GetFrameTime();
+
+        // key presses are edge events, keep them until a tick consumes them
+        debugKeys();
+        FrameInput polled = pollInput();
+        pending.reset     |= polled.reset;
+        pending.stand     |= polled.stand;
+        pending.throwBall |= polled.throwBall;
+
+        int steps = 0;
+        while (accumulator >= tickDt && steps < maxSubsteps) {
+            PROFILE_ZONE("tick");
+            savePreviousState();
+            processInput(pending);
+            pending = FrameInput{};
+            update(tickDt);
+            accumulator -= tickDt;
+            ++steps;
+        }
+        // too far behind: drop the backlog instead of spiralling
+        if (steps == maxSubsteps && accumulator >= tickDt)
+            accumulator = std::fmod(accumulator, tickDt);
+
+        capture(frameScene);
+        draw(frameScene, accumulator / tickDt);
+        PROFILE_FRAME();
+        frameAllocations = frameAllocs.allocations();
+    }
+
+    endSession();
+    printSceneCache();
+}
+
+// The simulation thread owns every piece of game state and keeps its own
+// fixed-tick clock; this thread polls input, picks up the newest snapshot
+// and draws it. Neither side waits for the other.
+void Game::runThreaded() {
+    const float tickDt = 1.0f / tickRate;
+    quit = false;
+    beginSession(tickDt);
+    std::thread sim(&Game::simulationLoop, this);
+    PROFILE_THREAD("render");
+
+    while (!WindowShouldClose()) {
+        allocs::Scope frameAllocs;
+        debugKeys();
+        FrameInput polled = pollInput();
+        if (polled.reset)     pendingReset = true;
+        if (polled.stand)     pendingStand = true;
+        if (polled.throwBall) pendingThrow = true;
+
+        if (!snapshots.acquire())
+            ++metrics.repeated;
+        const SceneSnapshot &scene = snapshots.front();
+
+        double now = clockSeconds();
+        metrics.ageMs = scene.tick > 0 ? (now - scene.publishedAt) * 1000.0 : 0.0;
+        metrics.maxAgeMs = std::max(metrics.maxAgeMs, metrics.ageMs);
+        metrics.sumAgeMs += metrics.ageMs;
+        metrics.published = publishedSnapshots.load(std::memory_order_relaxed);
+        metrics.dropped = droppedSnapshots.load(std::memory_order_relaxed);
+        ++metrics.frames;
+
+        // the snapshot is the newest tick, blend towards it as time passes
+        float alpha = std::min(static_cast<float>(metrics.ageMs / 1000.0) / tickDt, 1.0f);
+        draw(scene, alpha);
+        PROFILE_FRAME();
+        frameAllocations = frameAllocs.allocations();
+    }
+
+    quit = true;
+    sim.join();
+    endSession();
+    std::printf("threaded: %ld snapshots, %ld dropped, %ld frames (%ld repeated), "
+                "snapshot age avg %.2f ms max %.2f ms\n",
+                metrics.published, metrics.dropped, metrics.frames, metrics.repeated,
+                metrics.frames ? metrics.sumAgeMs / metrics.frames : 0.0, metrics.maxAgeMs);
+    printSceneCache();
+}
+
+void Game::simulationLoop() {
+    using clock = std::chrono::steady_clock;
+    const auto tick = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / tickRate));
+    const float tickDt = 1.0f / tickRate;
+    auto next = clock::now();
+    PROFILE_THREAD("simulation");
+
+    while (!quit.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_until(next);
+
+        int steps = 0;
+        while (clock::now() >= next && steps < maxSubsteps) {
+            PROFILE_ZONE("tick");
+            FrameInput in;
+            in.reset     = pendingReset.exchange(false);
+            in.stand     = pendingStand.exchange(false);
+            in.throwBall = pendingThrow.exchange(false);
+
+            savePreviousState();
+            processInput(in);
+            update(tickDt);
+
+            capture(snapshots.back());
+            if (snapshots.publish())
+                droppedSnapshots.fetch_add(1, std::memory_order_relaxed);
+            publishedSnapshots.fetch_add(1, std::memory_order_relaxed);
+            next += tick;
+            ++steps;
+        }
+        // too far behind: drop the backlog instead of spiralling
+        if (steps == maxSubsteps && clock::now() >= next)
+            next = clock::now() + tick;
+    }
+}
+
+HeadlessStats Game::runHeadless(long frames, float dt) {
+    using clock = std::chrono::steady_clock;
+    HeadlessStats stats;
+    PROFILE_THREAD("main");
+    beginSession(dt);
+
+    long steadyFrom = -1, allocStart = 0;
+    auto begin = clock::now();
+    for (long i = 0; i < frames; ++i) {
+        if (steadyFrom < 0 && resetCount > 0) {
+            steadyFrom = i;
+            allocStart = allocs::count();
+        }
+        stepHeadless(dt);
+        stats.cull += frameScene.cull;
+
+        bool numbered = renderPath.find('#') != std::string::npos;
+        bool save = numbered ? i % renderEvery == 0 : i == frames - 1;
+        if (software && i == 0)
+            warmRenderer();
+        if (software && save) {
+            auto renderStart = clock::now();
+            if (renderFrame(i)) {
+                stats.renderSeconds += std::chrono::duration<double>(clock::now() - renderStart).count();
+                ++stats.renderedFrames;
+            } else {
+                std::fprintf(stderr, "could not write %s\n", renderFile.c_str());
+                ++stats.failedSaves;
+            }
+        }
+    }
+    auto end = clock::now();
+    if (steadyFrom >= 0 && allocs::tracking()) {
+        stats.steadyAllocations = allocs::count() - allocStart;
+        stats.steadyFrames      = frames - steadyFrom;
+    }
+    if (stats.renderedFrames + stats.failedSaves > 0)
+        stats.imageChecksum = software->checksum();
+    endSession();
+
+    stats.frames      = frames;
+    stats.simSeconds  = frames * static_cast<double>(dt);
+    stats.wallSeconds = std::chrono::duration<double>(end - begin).count();
+    stats.throws      = throwCount;
+    stats.hits        = hitCount;
+    stats.resets      = resetCount;
+    stats.poseUpdates = posesComputed + walker.poseUpdates();
+    stats.poseSkips   = posesSkipped + walker.poseSkips();
+    return stats;
+}
+
+void Game::stepHeadless(float dt) {
+    processInput(scriptedInput());
+    update(dt);
+    capture(frameScene);
+}
+
+// ticks as fast as the simulation allows; nothing waits on the clock
+HeadlessStats Game::runReplay(InputLog &log) {
+    using clock = std::chrono::steady_clock;
+    HeadlessStats stats;
+    PROFILE_THREAD("main");
+    beginSession(log.tickDt());
+
+    const float dt = log.tickDt();
+    const long ticks = log.ticks();
+    long steadyFrom = -1, allocStart = 0;
+    auto begin = clock::now();
+    for (long i = 0; i < ticks; ++i) {
+        if (steadyFrom < 0 && resetCount > 0) {
+            steadyFrom = i;
+            allocStart = allocs::count();
+        }
+        processInput(log.inputAt(i));
         update(dt);
-        draw();
     }
+    auto end = clock::now();
+    if (steadyFrom >= 0 && allocs::tracking()) {
+        stats.steadyAllocations = allocs::count() - allocStart;
+        stats.steadyFrames      = ticks - steadyFrom;
+    }
+    endSession();
+
+    stats.frames      = ticks;
+    stats.simSeconds  = ticks * static_cast<double>(dt);
+    stats.wallSeconds = std::chrono::duration<double>(end - begin).count();
+    stats.throws      = throwCount;
+    stats.hits        = hitCount;
+    stats.resets      = resetCount;
+    stats.poseUpdates = posesComputed + walker.poseUpdates();
+    stats.poseSkips   = posesSkipped + walker.poseSkips();
+    return stats;
+}
+
+FrameInput Game::pollInput() {
+    FrameInput in;
+    in.reset     = IsKeyPressed(KEY_R);
+    in.stand     = IsKeyPressed(KEY_SPACE);
+    in.throwBall = IsKeyPressed(KEY_T);
+    return in;
 }
 
-void Game::processInput() {
-    if (IsKeyPressed(KEY_R)) {
+// Plays the game the way a player would: stand once the ball is grabbed,
+// throw once a target is up, reset after the ball lands. A stuck round
+// (ball out of reach) is reset after a few simulated seconds.
+FrameInput Game::scriptedInput() {
+    const long maxRoundFrames = rounds::maxTicks(sessionDt);
+    FrameInput in;
+
+    ++scriptFrames;
+    if (scriptFrames > maxRoundFrames
+        || (stickmanStand && !ballFlying && !throwAnimating && ball.state == BALL_AT_REST)) {
+        in.reset = true;
+        return in;
+    }
+
+    in.stand     = ballTouched && !stickmanStand;
+    in.throwBall = targetActive && stickmanStand && !ballFlying && !throwAnimating;
+    return in;
+}
+
+void Game::processInput(const FrameInput &in) {
+    PROFILE_ZONE("processInput");
+    if (!recordFile.empty())
+        recording.record(tickCount, in);
+    if (in.reset) {
         reset();
         return;
     }
@@ -54,7 +448,7 @@ void Game::processInput() {
         ballTouched = true;
     }
 
-    if (ballTouched && !stickmanStand && IsKeyPressed(KEY_SPACE)) {
+    if (ballTouched && !stickmanStand && in.stand) {
         stickmanStand = true;
         target        = randomTarget();
         targetActive  = true;
@@ -62,13 +456,21 @@ void Game::processInput() {
 
     walker.setStandUp(stickmanStand);
 
-    if (targetActive && stickmanStand && !ballFlying && IsKeyPressed(KEY_T)) {
+    if (targetActive && stickmanStand && !ballFlying && in.throwBall) {
         throwAnimating  = true;
         throwAnimTime   = 0.0f;
     }
 }
 
+void Game::savePreviousState() {
+    prevWalkerPose = walker.getPose();
+    prevBallPos    = ball.pos;
+    prevCameraX    = cameraX;
+}
+
 void Game::update(float dt) {
+    PROFILE_ZONE("update");
+    ++tickCount;
     walker.step();
 
     if (stickmanStand && !ballFlying && !throwAnimating) {
@@ -83,75 +485,340 @@ void Game::update(float dt) {
 
         if (phase >= 1.0f) {
             Vector2 start = walker.getHandPos();
-            ball.throwTo(start, target.getPos(), gravity, flightTime);
+            ThrowSolution shot = throwSolver.solve(start, target.getPos());
+            ball.throwTo(start, target.getPos(), gravity, shot.feasible ? shot.time : flightTime);
+            Circle aim = target.bounds();
+            ball.predict(groundY, &aim, 1);
+            targetHit      = false;
             ballFlying     = true;
             throwAnimating = false;
+            ++throwCount;
             walker.setThrowAnim(0.0f, 0.0f);
         }
     }
 
     if (ballFlying) {
         ball.update(gravity, dt, groundY);
+        if (ball.hitTarget >= 0 && !targetHit) {
+            targetHit = true;
+            ++hitCount;
+        }
         if (ball.getPos().y >= groundY - ball.getRadius()) {
             ballFlying = false;
             ball.setState(BALL_AT_REST);
         }
     }
+
+    // the camera trails the walker; bystanders near it get full animation
+    float pan = (cameraGoal() - cameraX) * kCameraFollow;
+    cameraX += std::min(std::max(pan, -kCameraMaxStep), kCameraMaxStep);
+    world.step(worldJobs, cameraX - screenW * 0.5f, cameraX + screenW * 0.5f);
+
+    // nothing sensible to blend from after a reset or before the first tick
+    if (snapInterpolation) {
+        savePreviousState();
+        snapInterpolation = false;
+    }
 }
 
-void Game::draw() {
-    BeginDrawing();
-    ClearBackground(RAYWHITE);
+void Game::capture(SceneSnapshot &out) const {
+    out.tick            = tickCount;
+    out.publishedAt     = clockSeconds();
+    out.prevPose        = prevWalkerPose;
+    out.pose            = walker.getPose();
+    out.prevBallPos     = prevBallPos;
+    out.ballPos         = ball.pos;
+    out.ballRadius      = ball.getRadius();
+    out.ballColor       = ball.color;
+    out.target          = target;
+    out.walkerBall      = walker.getBallCenter();
+    out.fingersTouching = walker.fingersTouchingBall();
+    out.targetActive    = targetActive;
+    out.targetHit       = targetHit;
+    out.ballTouched     = ballTouched;
+    out.stickmanStand   = stickmanStand;
+    out.ballFlying      = ballFlying;
+    out.prevCameraX     = prevCameraX;
+    out.cameraX         = cameraX;
+    out.poseUpdates     = posesComputed + walker.poseUpdates();
+    out.poseSkips       = posesSkipped + walker.poseSkips();
+
+    // cull against everything the camera can show until the next tick,
+    // which is at most one step of panning away
+    PROFILE_ZONE("cull");
+    float left  = cameraX - screenW * 0.5f - kCameraMaxStep - kCullMargin;
+    float right = cameraX + screenW * 0.5f + kCameraMaxStep + kCullMargin;
+    auto inView = [&](float minX, float maxX) { return maxX >= left && minX <= right; };
+    float minX, maxX;
+    poseExtentX(out.pose, minX, maxX);
+    out.drawWalker = inView(minX, maxX);
+    out.drawBall   = inView(ball.pos.x - ball.getRadius(), ball.pos.x + ball.getRadius());
+    out.drawTarget = targetActive && inView(target.pos.x - target.radius, target.pos.x + target.radius);
 
-    // ground line
-    DrawLine(0, (int)groundY, screenW, (int)groundY, BLACK);
+    CullStats &cull   = out.cull;
+    cull              = CullStats{};
+    cull.walkersDrawn = out.drawWalker;
+    cull.ballsDrawn   = out.drawBall;
+    cull.targetsDrawn = out.drawTarget;
+    cull.culled       = !out.drawWalker + !out.drawBall + (targetActive && !out.drawTarget);
+    if (out.bystanders.capacity() < world.maxVisible())
+        out.bystanders.reserve(world.maxVisible());
+    out.bystanders.clear();
+    world.gather(left, right, out.bystanders, cull);
+}
 
-    // scene
-    walker.draw();
-    ball.draw();
-    if (targetActive) target.draw();
+Camera2D Game::sceneCamera(const SceneSnapshot &scene, float alpha) const {
+    Camera2D camera = {};
+    camera.offset = { screenW * 0.5f, screenH * 0.5f };
+    camera.target = { scene.prevCameraX + (scene.cameraX - scene.prevCameraX) * alpha, screenH * 0.5f };
+    camera.zoom   = 1.0f;
+    return camera;
+}
+
+// Everything but text goes through the batch, so the window and the CPU
+// renderer draw the same primitives. The ground line sits on pixel row
+// groundY; then whatever capture() left in view: bystanders behind, then
+// the scene, blended between the previous and the current tick. Layers
+// keep the original order: walker, then ball, then target.
+void Game::recordScene(const SceneSnapshot &scene, float alpha) {
+    batch.setLayer(-4);
+    batch.line({ 0.0f, groundY + 0.5f }, { worldW, groundY + 0.5f }, BLACK);
+    World::draw(scene.bystanders, bystanderTargets, batch);
+    batch.setLayer(0);
+    if (scene.drawWalker)
+        Walker::draw(lerpPose(scene.prevPose, scene.pose, alpha), batch);
+    batch.setLayer(1);
+    if (scene.drawBall)
+        Ball::draw(batch, { scene.prevBallPos.x + (scene.ballPos.x - scene.prevBallPos.x) * alpha,
+                            scene.prevBallPos.y + (scene.ballPos.y - scene.prevBallPos.y) * alpha },
+                   scene.ballRadius, scene.ballColor);
+    batch.setLayer(2);
+    if (scene.drawTarget) scene.target.draw(batch);
+}
+
+void Game::setRenderOutput(const std::string &path, int every, unsigned threads) {
+    renderPath  = path;
+    renderFile.reserve(path.size() + 20); // room for any frame number
+    renderEvery = std::max(every, 1);
+    software    = std::make_unique<SoftwareRenderer>(screenW, screenH);
+    renderJobs  = std::make_unique<JobSystem>(threads);
+}
+
+// the last capture() on the CPU, into the renderer's image
+void Game::rasterize() {
+    PROFILE_ZONE("render");
+    recordScene(frameScene, 1.0f);
+    batch.build();
+    software->clear(RAYWHITE);
+    software->setCamera(sceneCamera(frameScene, 1.0f));
+    software->draw(batch, *renderJobs);
+    batch.clear();
+}
+
+// draws the first frame, target included, and throws it away, so the
+// batch, the target meshes and the renderer's buffers are sized before the
+// steady state starts
+void Game::warmRenderer() {
+    bool drawTarget = frameScene.drawTarget;
+    frameScene.drawTarget = true;
+    rasterize();
+    frameScene.drawTarget = drawTarget;
+}
+
+// rasterize() and save; false if the image could not be saved
+bool Game::renderFrame(long frame) {
+    rasterize();
+    renderFile = renderPath;
+    size_t hashes = renderFile.find('#');
+    if (hashes != std::string::npos) {
+        size_t digits = renderFile.find_first_not_of('#', hashes);
+        digits = (digits == std::string::npos ? renderFile.size() : digits) - hashes;
+        char number[24];
+        std::snprintf(number, sizeof number, "%0*ld", static_cast<int>(digits), frame);
+        renderFile.replace(hashes, digits, number);
+    }
+    return software->save(renderFile.c_str());
+}
+
+// 0 while anything on screen moves between the two ticks, otherwise a hash
+// of everything drawScene() would draw; equal keys draw equal frames
+uint64_t Game::staticSceneKey(const SceneSnapshot &scene) const {
+    if (std::memcmp(&scene.prevPose, &scene.pose, sizeof scene.pose) != 0
+        || scene.prevBallPos.x != scene.ballPos.x || scene.prevBallPos.y != scene.ballPos.y
+        || scene.prevCameraX != scene.cameraX)
+        return 0;
+
+    StateHash h;
+    h.add(scene.pose);
+    h.add(scene.ballPos);
+    h.add(scene.ballRadius);
+    h.add(scene.ballColor);
+    h.add(scene.target.pos);
+    h.add(scene.target.radius);
+    h.add(scene.target.color);
+    h.add(scene.walkerBall);
+    h.add(scene.cameraX);
+    uint32_t flags = scene.drawWalker | scene.drawBall << 1 | scene.drawTarget << 2 | scene.fingersTouching << 3
+                   | scene.targetHit << 4 | scene.ballTouched << 5 | scene.stickmanStand << 6
+                   | scene.ballFlying << 7;
+    h.add(flags);
+    for (const BystanderView &b : scene.bystanders) {
+        h.add(b.pose);
+        h.add(b.ball);
+        h.add(b.target);
+        h.add(static_cast<uint32_t>(b.drawWalker | b.drawBall << 1 | b.drawTarget << 2));
+    }
+    return h.value ? h.value : 1;
+}
+
+// the world, its labels and the HUD text; everything but the F1/F2 overlays
+void Game::drawScene(const SceneSnapshot &scene, float alpha) {
+    ClearBackground(RAYWHITE);
+
+    BeginMode2D(sceneCamera(scene, alpha));
+    recordScene(scene, alpha);
+    batch.flush();
+    if (scene.fingersTouching)
+        Walker::drawTouchLabel(scene.walkerBall);
+    if (scene.targetHit)
+        DrawText("HIT!", (int)scene.target.pos.x + 30, (int)scene.target.pos.y - 40, 20, GREEN);
+    EndMode2D();
 
-    // HUD
     DrawText("Press R to reset", 10, 10, 18, DARKGRAY);
-    if (!ballTouched)
+    if (!scene.ballTouched)
         DrawText("Move into the ball to grab it", 10, 35, 18, BLUE);
-    else if (!stickmanStand)
+    else if (!scene.stickmanStand)
         DrawText("Press SPACE to stand and aim", 10, 60, 18, BLUE);
-    else if (!ballFlying)
+    else if (!scene.ballFlying)
         DrawText("Press T to throw", 10, 85, 18, RED);
+}
+
+// A scene that stayed the same for two frames is rendered once into
+// sceneCache and then only blitted until its key changes; an idle session
+// costs one textured quad per frame. The overlays are always drawn live.
+void Game::draw(const SceneSnapshot &scene, float alpha) {
+    PROFILE_ZONE("draw");
+    uint64_t key = staticSceneKey(scene);
+    bool cached = key != 0 && key == lastSceneKey && sceneCache.id != 0;
+    lastSceneKey = key;
+    if (cached && key != cachedSceneKey) {
+        BeginTextureMode(sceneCache);
+        drawScene(scene, alpha);
+        EndTextureMode();
+        cachedSceneKey = key;
+        ++cacheStats.rebuilds;
+    } else if (cached) {
+        ++cacheStats.hits;
+    } else {
+        ++cacheStats.redraws;
+    }
+
+    BeginDrawing();
+    if (cached) {
+        // render textures are stored bottom-up
+        Rectangle flipped = { 0.0f, 0.0f, (float)sceneCache.texture.width, -(float)sceneCache.texture.height };
+        DrawTextureRec(sceneCache.texture, flipped, { 0.0f, 0.0f }, WHITE);
+    } else {
+        drawScene(scene, alpha);
+    }
 
+    if (showBatchStats) {
+        DrawText(TextFormat("scene cache %ld hits %ld rebuilds %ld redraws  walker poses %ld updated %ld skipped",
+                            cacheStats.hits, cacheStats.rebuilds, cacheStats.redraws, scene.poseUpdates,
+                            scene.poseSkips),
+                 10, screenH - 124, 18, DARKGRAY);
+        const PrimitiveBatch::Stats &s = batch.stats();
+        DrawText(TextFormat("primitives %d  vertices %d  draw calls %d", s.primitives, s.vertices, s.drawCalls),
+                 10, screenH - 28, 18, DARKGRAY);
+        const CullStats &c = scene.cull;
+        DrawText(TextFormat("drawn %ld walkers %ld balls %ld targets  culled %ld  skipped %ld",
+                            c.walkersDrawn, c.ballsDrawn, c.targetsDrawn, c.culled, c.skipped),
+                 10, screenH - 100, 18, DARKGRAY);
+        if (frameAllocations >= 0)
+            DrawText(TextFormat("heap allocations last frame %ld", frameAllocations), 10, screenH - 76, 18,
+                     frameAllocations ? RED : DARKGRAY);
+        if (threaded)
+            DrawText(TextFormat("snapshot age %.1f ms (max %.1f)  dropped %ld/%ld  repeated frames %ld",
+                                metrics.ageMs, metrics.maxAgeMs, metrics.dropped, metrics.published, metrics.repeated),
+                     10, screenH - 52, 18, DARKGRAY);
+    }
+    if (showProfiler)
+        drawProfiler();
+
+    // includes waiting for the frame cap / vsync
+    PROFILE_ZONE("EndDrawing");
     EndDrawing();
 }
 
-Ball Game::randomBall() {
-    float r = 16.0f + std::rand() % 18;            
-    float x = 400 + std::rand() % (screenW - 500); 
+void Game::printSceneCache() const {
+    long frames = cacheStats.hits + cacheStats.rebuilds + cacheStats.redraws;
+    std::printf("scene cache: %ld frames, %ld from the cache (%.1f%%), %ld rebuilds, %ld redrawn\n",
+                frames, cacheStats.hits, frames ? 100.0 * cacheStats.hits / frames : 0.0, cacheStats.rebuilds,
+                cacheStats.redraws);
+}
 
-    const int maxVerticalOffset = 200; 
+// per-zone times averaged over the last window of frames, and the recent
+// frame times as bars against the render budget
+void Game::drawProfiler() const {
+    const int w = 360, x = screenW - w - 10, y = 10;
+#ifndef OOCATCHER_PROFILE
+    DrawText("profiler compiled out (OOCATCHER_PROFILE=OFF)", x - 60, y, 16, DARKGRAY);
+#else
+    const profiler::Summary &s = profiler::summary();
+    const int graphH = 60;
+    const int rows = s.zoneCount + 1;
+    DrawRectangle(x - 6, y - 4, w + 12, rows * 16 + graphH + 16, Fade(LIGHTGRAY, 0.85f));
 
-    int minY = static_cast<int>(groundY - r - maxVerticalOffset);
-    int maxY = static_cast<int>(groundY - r);
-    float y = static_cast<float>(minY + (std::rand() % (maxY - minY + 1)));
+    DrawText(TextFormat("frame %.2f ms  max %.2f ms", s.lastFrameMs, s.maxFrameMs), x, y, 14, BLACK);
+    for (int i = 0; i < s.zoneCount; ++i) {
+        const profiler::ZoneStats &z = s.zones[i];
+        DrawText(TextFormat("%s", z.name), x + z.depth * 10, y + 16 * (i + 1), 14, DARKGRAY);
+        DrawText(TextFormat("%7.3f ms  x%-5.1f max %.3f", z.msPerFrame, z.calls, z.maxMs),
+                 x + 170, y + 16 * (i + 1), 14, DARKGRAY);
+    }
 
-    Color c = possibleColors[ std::rand() % possibleColors.size() ];
-    return Ball({ x, y }, r, c);
+    // bars scaled so the budget line sits halfway up, or to the worst frame
+    const int gy = y + rows * 16 + 6;
+    float budget = 1000.0f / (renderFps > 0 ? renderFps : 60);
+    float scale = graphH / std::max(2.0f * budget, s.maxFrameMs);
+    const int barW = w / profiler::kFrameHistory > 0 ? w / profiler::kFrameHistory : 1;
+    for (int i = 0; i < profiler::kFrameHistory; ++i) {
+        int h = static_cast<int>(s.frameMs[i] * scale);
+        DrawRectangle(x + i * barW, gy + graphH - h, barW, h, s.frameMs[i] > budget ? RED : DARKGREEN);
+    }
+    int by = gy + graphH - static_cast<int>(budget * scale);
+    DrawLine(x, by, x + w, by, BLACK);
+#endif
 }
 
+Ball Game::randomBall() {
+    return rounds::randomBall(rng, roundStart, screenW, groundY);
+}
 
+// somewhere on the screen the camera is heading for
 Target Game::randomTarget() {
-    float x = 100 + std::rand() % (screenW - 200);
-    float y = 100 + std::rand() % static_cast<int>(groundY - 200);
-    float r = 22.0f + std::rand() % 15;
-    Color c = possibleColors[std::rand() % possibleColors.size()];
-    return Target({ x, y }, r, c);
+    float left = std::min(std::max(cameraGoal() - screenW * 0.5f, 0.0f), worldW - screenW);
+    return rounds::randomTarget(rng, left, screenW, groundY);
 }
 
+// in a wide world the next round starts where the walker stands, and
+// back at the left end once it would run off the right one
 void Game::reset() {
+    roundStart = walker.getPose().torsoBottom.x;
+    if (roundStart < rounds::kStartX || roundStart + screenW > worldW)
+        roundStart = rounds::kStartX;
+    posesComputed += walker.poseUpdates();
+    posesSkipped  += walker.poseSkips();
     ball          = randomBall();
     walker        = Walker(ball.getPos(), ball.getRadius());
-    walker.init();
+    walker.init(roundStart, sessionDt);
     targetActive  = false;
     stickmanStand = false;
     ballTouched   = false;
     ballFlying    = false;
+    targetHit     = false;
+    throwAnimating = false;
+    snapInterpolation = true;
+    scriptFrames  = 0;
+    ++resetCount;
 }
@@ -3,15 +3,132 @@
 #include "Ball.h"
 #include "Walker.h"
 #include "Target.h"
+#include "PrimitiveBatch.h"
+#include "ThrowSolver.h"
+#include "InputLog.h"
+#include "JobSystem.h"
+#include "Rng.h"
+#include "Round.h"
+#include "SoftwareRenderer.h"
+#include "TripleBuffer.h"
+#include "World.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
 #include <vector>
 
+// everything draw() needs from one simulation tick, plus the tick before
+// it for interpolation; the render thread only ever sees these
+struct SceneSnapshot
+{
+	long tick = 0;
+	double publishedAt = 0.0; // seconds on Game's clock
+	WalkerPose prevPose{}, pose{};
+	Vector2 prevBallPos{}, ballPos{};
+	float ballRadius = 0.0f;
+	Color ballColor{};
+	Target target{{0, 0}, 0, WHITE};
+	Vector2 walkerBall{}; // where the walker's TOUCH! label goes
+	bool fingersTouching = false;
+	bool targetActive = false;
+	bool targetHit = false;
+	bool ballTouched = false;
+	bool stickmanStand = false;
+	bool ballFlying = false;
+	// camera x over the two ticks, and what survived culling against it
+	float prevCameraX = 0.0f, cameraX = 0.0f;
+	bool drawWalker = true, drawBall = true, drawTarget = true;
+	std::vector<BystanderView> bystanders;
+	CullStats cull;
+	// the player walker's pose updates, over every round so far
+	long poseUpdates = 0, poseSkips = 0;
+};
+
+// what draw() did with the cached static scene, one count per frame
+struct SceneCacheStats
+{
+	long hits = 0;     // drew the cached texture only
+	long rebuilds = 0; // rendered the scene into the cache, then drew it
+	long redraws = 0;  // something moved, drew the scene directly
+};
+
+// render-side view of the snapshot handoff in threaded mode
+struct SnapshotMetrics
+{
+	long published = 0;  // snapshots the simulation wrote
+	long dropped = 0;    // overwritten before the renderer picked them up
+	long frames = 0;     // frames drawn
+	long repeated = 0;   // frames that found no new snapshot
+	double ageMs = 0.0;  // snapshot age when drawn, last frame
+	double maxAgeMs = 0.0;
+	double sumAgeMs = 0.0;
+};
+
+struct HeadlessStats
+{
+	long frames = 0;
+	double simSeconds = 0.0;
+	double wallSeconds = 0.0;
+	int throws = 0;
+	int hits = 0;
+	int resets = 0;
+	// heap allocations once the first round has been reset, -1 when
+	// built without OOCATCHER_TRACK_ALLOCS or no reset happened
+	long steadyAllocations = -1;
+	long steadyFrames = 0;
+	CullStats cull; // summed over frames
+	// CPU rendering, when asked for with setRenderOutput
+	long renderedFrames = 0; // saved
+	long failedSaves = 0;    // rasterized but could not be written
+	double renderSeconds = 0.0; // of the saved frames
+	uint64_t imageChecksum = 0; // of the last rasterized frame
+	// player walker pose updates run and skipped as unchanged
+	long poseUpdates = 0;
+	long poseSkips = 0;
+};
+
 class Game
 {
 public:
-	Game(int screenW, int screenH);
+	// every random draw comes from `seed`, so a seed plus the per-tick
+	// input reproduces a session exactly; the world is `worldScreens`
+	// screens wide and the camera follows the walker through it
+	Game(int screenW, int screenH, bool headless = false, uint64_t seed = timeSeed(), int worldScreens = 1);
 	~Game();
 
+	static uint64_t timeSeed();
+	uint64_t seed() const { return sessionSeed; }
+	int worldScreens() const { return world.regions(); }
+	size_t bystanders() const { return world.bystanders(); }
+	// FNV-1a over the walker, ball, target and round state
+	uint64_t stateHash() const;
+
 	void run();
+	// fixed simulation tick; rendering runs at renderFps (0 = uncapped)
+	void setTickRate(float hz);
+	void setMaxSubsteps(int steps);
+	void setRenderFps(int fps);
+	// simulate on a second thread, handing snapshots to the render loop
+	void setThreaded(bool value);
+	// profile from the start and write the trace to `path` when the run
+	// ends: Chrome trace_event JSON for *.json, CSV otherwise
+	void setTraceFile(const std::string &path);
+	// drives update() with a synthetic clock and scripted input, never draws
+	HeadlessStats runHeadless(long frames, float dt);
+	// one tick of runHeadless() without the session around it: scripted
+	// input, update() and the snapshot a frame would draw
+	void stepHeadless(float dt);
+	// record every tick's input and save it to `path` when the run ends
+	void setRecordFile(const std::string &path);
+	// headless only: rasterize frames on the CPU and save them to `path`;
+	// a run of '#' in it becomes the zero-padded frame number and every
+	// `every`th frame is saved, otherwise only the last one is.
+	// `threads` counts the caller, 0 is one per hardware thread
+	void setRenderOutput(const std::string &path, int every = 1, unsigned threads = 0);
+	// feeds a recorded session back tick by tick as fast as possible;
+	// the Game must have been built with log.seed()
+	HeadlessStats runReplay(InputLog &log);
 
 private:
 	// --- setup helpers ---
@@ -19,9 +136,30 @@ private:
 	void initGame();
 
 	// --- per-frame ---
-	void processInput();
+	FrameInput pollInput();
+	FrameInput scriptedInput();
+	void processInput(const FrameInput &in);
 	void update(float dt);
-	void draw();
+	void savePreviousState();
+	void capture(SceneSnapshot &out) const;
+	void draw(const SceneSnapshot &scene, float alpha);
+	Camera2D sceneCamera(const SceneSnapshot &scene, float alpha) const;
+	void recordScene(const SceneSnapshot &scene, float alpha);
+	void drawScene(const SceneSnapshot &scene, float alpha);
+	uint64_t staticSceneKey(const SceneSnapshot &scene) const;
+	void printSceneCache() const;
+	void rasterize();
+	void warmRenderer();
+	bool renderFrame(long frame);
+	void drawProfiler() const;
+	void debugKeys();
+	void writeTrace(const std::string &path) const;
+	void beginSession(float tickDt);
+	void endSession();
+	void runThreaded();
+	void simulationLoop();
+	double clockSeconds() const;
+	float cameraGoal() const;
 
 	// --- factory / reset ---
 	Ball randomBall();
@@ -31,26 +169,91 @@ private:
 	// --- window & ground ---
 	int screenW;
 	int screenH;
+	bool headless;
 	float groundY;
+	float worldW;
+	float roundStart = rounds::kStartX; // where the walker starts this round
 
-	// **declare colors first!**
-	std::vector<Color> possibleColors;
+	// session randomness, ahead of everything it is used to build
+	uint64_t sessionSeed;
+	Rng rng;
 
-	// now these come *after* possibleColors
+	// drawn from rng, so they come after it
 	Ball ball;
 	Walker walker;
 	Target target;
 
+	// bystanders filling the rest of the world; stepped on one thread,
+	// CrowdScene is the same for any thread count
+	World world;
+	JobSystem worldJobs{1};
+	float cameraX = 0.0f, prevCameraX = 0.0f;
+
 	// game state
 	bool targetActive = false;
 	bool stickmanStand = false;
 	bool ballTouched = false;
 	bool ballFlying = false;
 	bool throwAnimating = false;
+	bool targetHit = false;
 
 	// physics / timing
 	float flightTime;
 	float gravity;
 	float throwAnimDuration;
 	float throwAnimTime;
+	ThrowSolver throwSolver; // flightTime is the fallback when no throw fits
+
+	// fixed-step clock and render interpolation
+	float tickRate = rounds::kTickRate;
+	float sessionDt = 1.0f / rounds::kTickRate; // tick of the running session, walkers move per second of it
+	int maxSubsteps = 5;
+	int renderFps = 60;
+	WalkerPose prevWalkerPose;
+	Vector2 prevBallPos;
+	bool snapInterpolation = true;
+	long tickCount = 0;
+
+	// threaded mode: input flags set by the render thread, taken by the
+	// simulation thread; snapshots go the other way
+	bool threaded = false;
+	std::atomic<bool> quit{false};
+	std::atomic<bool> pendingReset{false}, pendingStand{false}, pendingThrow{false};
+	TripleBuffer<SceneSnapshot> snapshots;
+	std::atomic<long> publishedSnapshots{0}, droppedSnapshots{0};
+	SnapshotMetrics metrics;
+	SceneSnapshot frameScene; // single-threaded mode draws from this
+	std::chrono::steady_clock::time_point clockStart = std::chrono::steady_clock::now();
+
+	// rendering
+	PrimitiveBatch batch;
+	std::vector<Target> bystanderTargets; // World::draw's buffer, reserved once
+	bool showBatchStats = false;
+	bool showProfiler = false;
+	long frameAllocations = -1; // last rendered frame, all threads
+
+	// the scene once nothing in it moves, keyed by staticSceneKey()
+	RenderTexture2D sceneCache{};
+	uint64_t cachedSceneKey = 0, lastSceneKey = 0;
+	SceneCacheStats cacheStats;
+	std::string traceFile;
+
+	// CPU rendering of headless runs
+	std::unique_ptr<SoftwareRenderer> software;
+	std::unique_ptr<JobSystem> renderJobs;
+	std::string renderPath;
+	std::string renderFile; // renderPath with the frame number, reused
+	int renderEvery = 1;
+
+	// input recording
+	std::string recordFile;
+	InputLog recording;
+
+	// headless autopilot
+	int scriptFrames = 0;
+	int throwCount = 0;
+	int hitCount = 0;
+	int resetCount = 0;
+	// pose updates of the walkers reset() has replaced
+	long posesComputed = 0, posesSkipped = 0;
 };
@@ -0,0 +1,150 @@
+#include "IK.h"
+#include "FastTrig.h"
+#include <cmath>
+
+namespace
+{
+    struct LibmTrig
+    {
+        static float sin(float x) { return sinf(x); }
+        static float cos(float x) { return cosf(x); }
+        static float acos(float x) { return acosf(x); }
+        static float atan2(float y, float x) { return atan2f(y, x); }
+    };
+
+    struct SelectedTrig
+    {
+        static float sin(float x) { return trig::sin(x); }
+        static float cos(float x) { return trig::cos(x); }
+        static float acos(float x) { return trig::acos(x); }
+        static float atan2(float y, float x) { return trig::atan2(y, x); }
+    };
+
+    template <class Trig>
+    TwoBoneResult solve(Vector2 root, Vector2 target, float len1, float len2, float bend)
+    {
+        Vector2 d = {target.x - root.x, target.y - root.y};
+        float len = sqrtf(d.x * d.x + d.y * d.y);
+        len = fminf(len, len1 + len2 - 1.0f);
+
+        float a = Trig::acos(fmaxf(-1.0f, fminf(1.0f, (len1 * len1 + len * len - len2 * len2) / (2 * len1 * len))));
+        float b = Trig::atan2(d.x, d.y);
+
+        TwoBoneResult r;
+        r.theta1 = b + bend * a;
+        r.theta2 = PI - Trig::acos(fmaxf(-1.0f, fminf(1.0f, (len1 * len1 + len2 * len2 - len * len) / (2 * len1 * len2))));
+        float tipAngle = r.theta1 - copysignf(r.theta2, bend);
+        r.joint = {
+            root.x + len1 * Trig::sin(r.theta1),
+            root.y + len1 * Trig::cos(r.theta1)};
+        r.tip = {
+            r.joint.x + len2 * Trig::sin(tipAngle),
+            r.joint.y + len2 * Trig::cos(tipAngle)};
+        return r;
+    }
+}
+
+TwoBoneResult solveTwoBone(Vector2 root, Vector2 target, float len1, float len2, float bend)
+{
+    return solve<SelectedTrig>(root, target, len1, len2, bend);
+}
+
+TwoBoneResult solveTwoBoneReference(Vector2 root, Vector2 target, float len1, float len2, float bend)
+{
+    return solve<LibmTrig>(root, target, len1, len2, bend);
+}
+
+static void solveRange(const TwoBoneBatch &b, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        TwoBoneResult r = solveTwoBoneReference({b.rootX[i], b.rootY[i]}, {b.targetX[i], b.targetY[i]},
+                                                b.len1[i], b.len2[i], b.bend[i]);
+        b.theta1[i] = r.theta1;
+        b.theta2[i] = r.theta2;
+        b.jointX[i] = r.joint.x;
+        b.jointY[i] = r.joint.y;
+        b.tipX[i] = r.tip.x;
+        b.tipY[i] = r.tip.y;
+    }
+}
+
+void solveTwoBoneBatchScalar(const TwoBoneBatch &batch, size_t n)
+{
+    solveRange(batch, 0, n);
+}
+
+#ifdef OOCATCHER_SIMD
+
+namespace
+{
+    using simd::Ops;
+    using V = Ops::V;
+
+    using trig::acosv;
+    using trig::atan2v;
+    using trig::cosv;
+    using trig::signMask;
+    using trig::sinv;
+
+    V clampUnit(V v)
+    {
+        return Ops::max(Ops::set1(-1.0f), Ops::min(v, Ops::set1(1.0f)));
+    }
+
+    void solveWide(const TwoBoneBatch &b, size_t i)
+    {
+        V rx = Ops::load(b.rootX + i), ry = Ops::load(b.rootY + i);
+        V l1 = Ops::load(b.len1 + i), l2 = Ops::load(b.len2 + i);
+        V bend = Ops::load(b.bend + i);
+        V dx = Ops::sub(Ops::load(b.targetX + i), rx);
+        V dy = Ops::sub(Ops::load(b.targetY + i), ry);
+
+        V len = Ops::sqrt(Ops::add(Ops::mul(dx, dx), Ops::mul(dy, dy)));
+        len = Ops::min(len, Ops::sub(Ops::add(l1, l2), Ops::set1(1.0f)));
+
+        V l1sq = Ops::mul(l1, l1), l2sq = Ops::mul(l2, l2), lensq = Ops::mul(len, len);
+        V two = Ops::set1(2.0f);
+        V a = acosv(clampUnit(Ops::div(Ops::sub(Ops::add(l1sq, lensq), l2sq), Ops::mul(Ops::mul(two, l1), len))));
+        V theta1 = Ops::add(atan2v(dx, dy), Ops::mul(bend, a));
+        V theta2 = Ops::sub(Ops::set1(PI), acosv(clampUnit(Ops::div(Ops::sub(Ops::add(l1sq, l2sq), lensq),
+                                                                        Ops::mul(Ops::mul(two, l1), l2)))));
+        V tipAngle = Ops::sub(theta1, Ops::xorv(theta2, Ops::andv(bend, signMask())));
+
+        V jx = Ops::add(rx, Ops::mul(l1, sinv(theta1)));
+        V jy = Ops::add(ry, Ops::mul(l1, cosv(theta1)));
+        Ops::store(b.theta1 + i, theta1);
+        Ops::store(b.theta2 + i, theta2);
+        Ops::store(b.jointX + i, jx);
+        Ops::store(b.jointY + i, jy);
+        Ops::store(b.tipX + i, Ops::add(jx, Ops::mul(l2, sinv(tipAngle))));
+        Ops::store(b.tipY + i, Ops::add(jy, Ops::mul(l2, cosv(tipAngle))));
+    }
+}
+
+void solveTwoBoneBatch(const TwoBoneBatch &batch, size_t n)
+{
+    size_t i = 0;
+    for (; i + Ops::width <= n; i += Ops::width)
+        solveWide(batch, i);
+    solveRange(batch, i, n);
+}
+
+const char *ikBackendName()
+{
+    return Ops::name;
+}
+
+#else
+
+void solveTwoBoneBatch(const TwoBoneBatch &batch, size_t n)
+{
+    solveRange(batch, 0, n);
+}
+
+const char *ikBackendName()
+{
+    return "scalar";
+}
+
+#endif
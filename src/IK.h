@@ -0,0 +1,45 @@
+#pragma once
+#include "raylib.h"
+#include <cstddef>
+
+// Two-bone inverse kinematics shared by Walker and WalkerPool.
+//
+// Angles follow the Walker convention: measured from straight down (+y),
+// so a bone of length l at angle a ends at root + l * (sin a, cos a).
+// `bend` blends the first bone away from the root->target line:
+// legs pass the knee blend (0..1), the reaching arm passes -1.
+
+struct TwoBoneResult
+{
+    float theta1, theta2;
+    Vector2 joint, tip;
+};
+
+// Walker's solver. Its trig comes from FastTrig.h, so it is bit-for-bit
+// solveTwoBoneReference unless OOCATCHER_TRIG picks an approximation.
+TwoBoneResult solveTwoBone(Vector2 root, Vector2 target, float len1, float len2, float bend);
+
+// Same formulas on libm; the accuracy reference for the benches.
+TwoBoneResult solveTwoBoneReference(Vector2 root, Vector2 target, float len1, float len2, float bend);
+
+// Struct-of-arrays batch. Inputs may alias each other, outputs must not.
+struct TwoBoneBatch
+{
+    const float *rootX, *rootY;
+    const float *targetX, *targetY;
+    const float *len1, *len2;
+    const float *bend;
+
+    float *theta1, *theta2;
+    float *jointX, *jointY;
+    float *tipX, *tipY;
+};
+
+// Uses AVX2 or SSE2 when the compiler targets them, with polynomial
+// trig accurate to ~1e-6 rad; leftover elements go through the scalar path.
+// solveTwoBoneBatchScalar is solveTwoBoneReference over the whole batch.
+void solveTwoBoneBatch(const TwoBoneBatch &batch, size_t n);
+void solveTwoBoneBatchScalar(const TwoBoneBatch &batch, size_t n);
+
+// Name of the instruction set solveTwoBoneBatch was compiled for.
+const char *ikBackendName();
@@ -0,0 +1,161 @@
+#include "InputLog.h"
+#include <cstdio>
+#include <cstring>
+
+static constexpr char kMagic[4] = {'O', 'O', 'C', 'R'};
+static constexpr uint32_t kVersion = 2; // 2 added the world width; 1 is read as one screen
+// enough for a long session without the log growing while recording
+static constexpr size_t kReservedEvents = 4096;
+
+enum : uint8_t
+{
+    INPUT_RESET = 1,
+    INPUT_STAND = 2,
+    INPUT_THROW = 4
+};
+
+// fixed-width fields are little-endian regardless of the host
+static void putU(std::vector<uint8_t> &out, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+static bool getU(const std::vector<uint8_t> &in, size_t &at, uint64_t &v, int bytes)
+{
+    if (in.size() - at < static_cast<size_t>(bytes))
+        return false;
+    v = 0;
+    for (int i = 0; i < bytes; ++i)
+        v |= static_cast<uint64_t>(in[at++]) << (8 * i);
+    return true;
+}
+
+static void putVarint(std::vector<uint8_t> &out, uint64_t v)
+{
+    while (v >= 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+static bool getVarint(const std::vector<uint8_t> &in, size_t &at, uint64_t &v)
+{
+    v = 0;
+    for (int shift = 0; at < in.size() && shift < 64; shift += 7)
+    {
+        uint8_t b = in[at++];
+        v |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if (!(b & 0x80))
+            return true;
+    }
+    return false;
+}
+
+void InputLog::begin(uint64_t seed, float tickDt, int worldScreens)
+{
+    sessionSeed = seed;
+    dt = tickDt;
+    screens = worldScreens;
+    tickCount = 0;
+    hash = 0;
+    events.clear();
+    events.reserve(kReservedEvents);
+    cursor = 0;
+}
+
+void InputLog::record(long tick, const FrameInput &in)
+{
+    uint8_t bits = (in.reset ? INPUT_RESET : 0) | (in.stand ? INPUT_STAND : 0) | (in.throwBall ? INPUT_THROW : 0);
+    if (bits)
+        events.push_back({tick, bits});
+}
+
+void InputLog::finish(long ticks, uint64_t finalHash)
+{
+    tickCount = ticks;
+    hash = finalHash;
+}
+
+bool InputLog::save(const char *path) const
+{
+    std::vector<uint8_t> out(kMagic, kMagic + 4);
+    uint32_t dtBits;
+    std::memcpy(&dtBits, &dt, sizeof dtBits);
+    putU(out, kVersion, 4);
+    putU(out, sessionSeed, 8);
+    putU(out, dtBits, 4);
+    putU(out, static_cast<uint64_t>(tickCount), 8);
+    putU(out, hash, 8);
+    putU(out, static_cast<uint64_t>(screens), 4);
+    putU(out, events.size(), 4);
+    long last = 0;
+    for (const Event &e : events)
+    {
+        putVarint(out, static_cast<uint64_t>(e.tick - last));
+        out.push_back(e.bits);
+        last = e.tick;
+    }
+
+    FILE *f = std::fopen(path, "wb");
+    if (!f)
+        return false;
+    bool ok = std::fwrite(out.data(), 1, out.size(), f) == out.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+bool InputLog::load(const char *path)
+{
+    FILE *f = std::fopen(path, "rb");
+    if (!f)
+        return false;
+    std::vector<uint8_t> in;
+    uint8_t chunk[4096];
+    for (size_t n; (n = std::fread(chunk, 1, sizeof chunk, f)) > 0;)
+        in.insert(in.end(), chunk, chunk + n);
+    std::fclose(f);
+
+    size_t at = 4;
+    uint64_t version, seed, dtBits, ticks, finalHash, worldScreens = 1, count;
+    if (in.size() < 4 || std::memcmp(in.data(), kMagic, 4) != 0
+        || !getU(in, at, version, 4) || version < 1 || version > kVersion
+        || !getU(in, at, seed, 8) || !getU(in, at, dtBits, 4) || !getU(in, at, ticks, 8)
+        || !getU(in, at, finalHash, 8) || (version >= 2 && !getU(in, at, worldScreens, 4))
+        || !getU(in, at, count, 4) || worldScreens < 1)
+        return false;
+
+    std::vector<Event> loaded;
+    long tick = 0;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        uint64_t delta;
+        if (!getVarint(in, at, delta) || at >= in.size())
+            return false;
+        tick += static_cast<long>(delta);
+        loaded.push_back({tick, in[at++]});
+    }
+
+    uint32_t bits32 = static_cast<uint32_t>(dtBits);
+    begin(seed, 0.0f, static_cast<int>(worldScreens));
+    std::memcpy(&dt, &bits32, sizeof dt);
+    events.swap(loaded);
+    finish(static_cast<long>(ticks), finalHash);
+    return true;
+}
+
+FrameInput InputLog::inputAt(long tick)
+{
+    FrameInput in;
+    while (cursor < events.size() && events[cursor].tick < tick)
+        ++cursor;
+    if (cursor < events.size() && events[cursor].tick == tick)
+    {
+        uint8_t bits = events[cursor].bits;
+        in.reset     = bits & INPUT_RESET;
+        in.stand     = bits & INPUT_STAND;
+        in.throwBall = bits & INPUT_THROW;
+    }
+    return in;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// one frame worth of player commands, either polled from raylib or scripted
+struct FrameInput
+{
+    bool reset = false;
+    bool stand = false;
+    bool throwBall = false;
+};
+
+// Per-tick player input of one session, with the seed, tick length and
+// world width it ran under and the state hash it ended on: replaying the inputs into a
+// Game built from the same seed must land on the same hash.
+//
+// Only ticks with input are kept. On disk, after a fixed header, each one
+// is a LEB128 tick delta and a byte of input bits, so a minute of play is
+// a few dozen bytes.
+class InputLog
+{
+public:
+    // recording
+    void begin(uint64_t seed, float tickDt, int worldScreens = 1);
+    void record(long tick, const FrameInput &in); // ticks in increasing order
+    void finish(long ticks, uint64_t finalHash);
+
+    bool save(const char *path) const;
+    bool load(const char *path); // false if missing, truncated or not a log
+
+    uint64_t seed() const { return sessionSeed; }
+    float tickDt() const { return dt; }
+    int worldScreens() const { return screens; }
+    long ticks() const { return tickCount; }
+    uint64_t finalHash() const { return hash; }
+    size_t inputCount() const { return events.size(); }
+
+    // replay: input for each tick, asked for in increasing order
+    FrameInput inputAt(long tick);
+
+private:
+    struct Event
+    {
+        long tick;
+        uint8_t bits;
+    };
+
+    uint64_t sessionSeed = 0;
+    float dt = 1.0f / 60.0f;
+    int screens = 1;
+    long tickCount = 0;
+    uint64_t hash = 0;
+    std::vector<Event> events;
+    size_t cursor = 0;
+};
@@ -0,0 +1,178 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+
+// index of the calling thread's queue within the pool that owns it
+static thread_local const JobSystem *tlsPool = nullptr;
+static thread_local unsigned tlsIndex = 0;
+
+JobSystem::JobSystem(unsigned threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threads; ++i)
+        queues.push_back(std::make_unique<Queue>());
+    for (unsigned i = 1; i < threads; ++i)
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &w : workers)
+        w.join();
+}
+
+unsigned JobSystem::currentIndex() const
+{
+    return tlsPool == this ? tlsIndex : 0;
+}
+
+void JobSystem::run(const Job &job)
+{
+    job.fn(job.ctx, job.begin, job.end);
+    job.pending->fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::push(Job job)
+{
+    job.pending->fetch_add(1, std::memory_order_relaxed);
+    Queue &q = *queues[currentIndex()];
+    bool stored = false;
+    {
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (q.size < Queue::kCapacity)
+        {
+            q.jobs[(q.head + q.size++) % Queue::kCapacity] = job;
+            stored = true;
+        }
+    }
+    if (!stored)
+    {
+        run(job);
+        return;
+    }
+    if (queued.fetch_add(1, std::memory_order_release) == 0)
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        wake.notify_all();
+    }
+}
+
+bool JobSystem::popLocal(unsigned self, Job &out)
+{
+    Queue &q = *queues[self];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (q.size == 0)
+        return false;
+    out = q.jobs[(q.head + --q.size) % Queue::kCapacity];
+    return true;
+}
+
+bool JobSystem::steal(unsigned self, Job &out)
+{
+    unsigned n = threadCount();
+    for (unsigned k = 1; k < n; ++k)
+    {
+        Queue &q = *queues[(self + k) % n];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (q.size == 0)
+            continue;
+        out = q.jobs[q.head];
+        q.head = (q.head + 1) % Queue::kCapacity;
+        --q.size;
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::tryRunOne(unsigned self)
+{
+    Job job;
+    if (!popLocal(self, job) && !steal(self, job))
+        return false;
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    run(job);
+    return true;
+}
+
+void JobSystem::wait(const std::atomic<int> &pending)
+{
+    unsigned self = currentIndex();
+    while (pending.load(std::memory_order_acquire) > 0)
+        if (!tryRunOne(self))
+            std::this_thread::yield();
+}
+
+void JobSystem::workerLoop(unsigned index)
+{
+    tlsPool = this;
+    tlsIndex = index;
+    PROFILE_THREAD("job worker");
+    int idle = 0;
+    while (!stopping.load(std::memory_order_relaxed))
+    {
+        if (tryRunOne(index))
+        {
+            idle = 0;
+            continue;
+        }
+        // spin briefly between the bursts of a frame, then sleep
+        if (++idle < 256)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wake.wait(guard, [this]
+                  { return stopping.load() || queued.load() > 0; });
+        idle = 0;
+    }
+}
+
+TaskGraph::TaskId TaskGraph::add(std::function<void()> fn, std::initializer_list<TaskId> dependsOn)
+{
+    TaskId id = static_cast<TaskId>(nodes.size());
+    nodes.push_back({std::move(fn), {}, 0});
+    for (TaskId d : dependsOn)
+    {
+        nodes[d].successors.push_back(id);
+        nodes[id].dependencies++;
+    }
+    remaining.reset();
+    return id;
+}
+
+void TaskGraph::clear()
+{
+    nodes.clear();
+    remaining.reset();
+}
+
+void TaskGraph::runNode(void *ctx, size_t node, size_t)
+{
+    RunContext &run = *static_cast<RunContext *>(ctx);
+    TaskGraph &g = *run.graph;
+    g.nodes[node].fn();
+    for (TaskId s : g.nodes[node].successors)
+        if (g.remaining[s].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            run.jobs->spawn(&TaskGraph::runNode, ctx, s, 0, run.pending);
+}
+
+void TaskGraph::run(JobSystem &jobs)
+{
+    if (!remaining)
+        remaining.reset(new std::atomic<int>[nodes.size()]);
+    for (size_t i = 0; i < nodes.size(); ++i)
+        remaining[i].store(nodes[i].dependencies, std::memory_order_relaxed);
+
+    RunContext ctx{this, &jobs, {0}};
+    for (size_t i = 0; i < nodes.size(); ++i)
+        if (nodes[i].dependencies == 0)
+            jobs.spawn(&TaskGraph::runNode, &ctx, i, 0, ctx.pending);
+    jobs.wait(ctx.pending);
+}
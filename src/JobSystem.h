@@ -0,0 +1,136 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Work-stealing thread pool.
+//
+// Every thread (the workers plus whichever thread calls in) owns a bounded
+// job queue: it pushes and pops at the back, idle threads steal from the
+// front of the others. Waiting threads keep running jobs instead of
+// blocking, so jobs may themselves call parallelFor or run a TaskGraph.
+//
+// parallelFor splits [0, count) into chunks of `grain` regardless of the
+// thread count; as long as each chunk only writes its own elements and any
+// per-chunk results are combined in chunk order, the outcome is the same
+// on 1 thread or 64.
+class JobSystem
+{
+public:
+    // `threads` counts the calling thread; 0 picks one per hardware thread
+    explicit JobSystem(unsigned threads = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    unsigned threadCount() const { return static_cast<unsigned>(queues.size()); }
+
+    // body(begin, end) for each chunk; returns once all chunks ran
+    template <class F>
+    void parallelFor(size_t count, size_t grain, F &&body)
+    {
+        if (count == 0)
+            return;
+        grain = grain ? grain : 1;
+        if (count <= grain || queues.size() == 1)
+        {
+            for (size_t b = 0; b < count; b += grain)
+                body(b, b + grain < count ? b + grain : count);
+            return;
+        }
+        using Body = std::remove_reference_t<F>;
+        std::atomic<int> pending{0};
+        for (size_t b = 0; b < count; b += grain)
+            push({[](void *ctx, size_t begin, size_t end)
+                  { (*static_cast<Body *>(ctx))(begin, end); },
+                  const_cast<void *>(static_cast<const void *>(&body)),
+                  b, b + grain < count ? b + grain : count, &pending});
+        wait(pending);
+    }
+
+    // queues fn(ctx, a, b) as a job; `pending` goes up by one now and back
+    // down when fn returns
+    void spawn(void (*fn)(void *, size_t, size_t), void *ctx, size_t a, size_t b, std::atomic<int> &pending)
+    {
+        push({fn, ctx, a, b, &pending});
+    }
+
+    // runs queued jobs until pending drops to zero
+    void wait(const std::atomic<int> &pending);
+
+private:
+    struct Job
+    {
+        void (*fn)(void *ctx, size_t begin, size_t end);
+        void *ctx;
+        size_t begin, end;
+        std::atomic<int> *pending;
+    };
+
+    // fixed ring; a push into a full queue runs the job inline instead
+    struct Queue
+    {
+        static constexpr size_t kCapacity = 4096;
+        std::mutex lock;
+        Job jobs[kCapacity];
+        size_t head = 0, size = 0;
+    };
+
+    void push(Job job);
+    bool popLocal(unsigned self, Job &out);
+    bool steal(unsigned self, Job &out);
+    bool tryRunOne(unsigned self);
+    static void run(const Job &job);
+    unsigned currentIndex() const;
+    void workerLoop(unsigned index);
+
+    std::vector<std::unique_ptr<Queue>> queues; // [0] belongs to outside callers
+    std::vector<std::thread> workers;
+    std::atomic<int> queued{0};
+    std::atomic<bool> stopping{false};
+    std::mutex sleepLock;
+    std::condition_variable wake;
+};
+
+// Fixed set of tasks with dependencies, built once and run as often as
+// needed (for example once per simulation tick). A task starts after all
+// of the tasks it depends on have finished; tasks may use parallelFor.
+class TaskGraph
+{
+public:
+    using TaskId = int;
+
+    // dependencies must already be in the graph
+    TaskId add(std::function<void()> fn, std::initializer_list<TaskId> dependsOn = {});
+    void clear();
+    size_t size() const { return nodes.size(); }
+
+    void run(JobSystem &jobs);
+
+private:
+    struct Node
+    {
+        std::function<void()> fn;
+        std::vector<TaskId> successors;
+        int dependencies = 0;
+    };
+
+    struct RunContext
+    {
+        TaskGraph *graph;
+        JobSystem *jobs;
+        std::atomic<int> pending;
+    };
+
+    static void runNode(void *ctx, size_t node, size_t);
+
+    std::vector<Node> nodes;
+    std::unique_ptr<std::atomic<int>[]> remaining;
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+
+// How much work a walker gets, from full detail down to a stick figure.
+//
+//   FULL        every tick; fingers, joint dots, head outline; the ball is
+//               grabbed when all three fingers touch it
+//   MEDIUM      every tick; no fingers or joint dots
+//   LOW         every 2nd tick; bare limbs and a filled head
+//   SILHOUETTE  every 4th tick; one line per limb and the torso
+//
+// Below FULL the grab test only checks the hand against the ball.
+enum LodTier : uint8_t
+{
+    LOD_FULL,
+    LOD_MEDIUM,
+    LOD_LOW,
+    LOD_SILHOUETTE,
+    LOD_TIERS
+};
+
+// Picks a tier from a walker's height on screen and its distance from the
+// camera. A walker only moves to a finer tier once it is `hysteresis`
+// past the threshold, so one sitting on a boundary does not flicker.
+struct LodPolicy
+{
+    float minHeight[LOD_TIERS - 1] = {120.0f, 40.0f, 12.0f}; // px, for FULL, MEDIUM, LOW
+    float maxDistance[LOD_TIERS - 1] = {8.0f, 20.0f, 40.0f}; // world units, same order
+    float hysteresis = 0.15f;
+    int updateInterval[LOD_TIERS] = {1, 1, 2, 4};
+
+    LodTier select(LodTier current, float screenHeight, float distance) const
+    {
+        for (int t = 0; t < LOD_TIERS - 1; ++t)
+        {
+            // finer than now: must clear the threshold by the margin;
+            // as fine or coarser: the threshold minus the margin is enough
+            float slack = t < current ? 1.0f + hysteresis : 1.0f - hysteresis;
+            if (screenHeight >= minHeight[t] * slack && distance * slack <= maxDistance[t])
+                return static_cast<LodTier>(t);
+        }
+        return LOD_SILHOUETTE;
+    }
+};
+
+inline const char *lodName(LodTier tier)
+{
+    static const char *names[LOD_TIERS] = {"full", "medium", "low", "silhouette"};
+    return tier < LOD_TIERS ? names[tier] : "?";
+}
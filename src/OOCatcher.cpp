@@ -1,6 +0,0 @@
-#include "OOCatcher.h"
-OOCatcher::~OOCatcher()
-{
-	for (auto s : segments)
-		delete s;
-}
\ No newline at end of file
@@ -1,12 +1,22 @@
 #pragma once
-#include <vector>
-#include "BodySegment.h"
+#include "Skeleton.h"
+
+// Base for catcher kinds, bound at compile time (CRTP): there is no vtable.
+// A kind provides
+//     void init();
+//     void step();
+//     void draw(PrimitiveBatch &batch) const;
+// and is stored by value in an EntityStore, which calls these directly.
+template <class Derived>
 class OOCatcher
 {
 public:
-    std::vector<BodySegment *> segments;
-    virtual void init() = 0;
-    virtual void step() = 0;
-    virtual void draw() = 0;
-    virtual ~OOCatcher();
-};
\ No newline at end of file
+    Derived &self() { return static_cast<Derived &>(*this); }
+    const Derived &self() const { return static_cast<const Derived &>(*this); }
+
+protected:
+    OOCatcher() = default;
+
+    // posed by the kind when someone asks for it, not every step
+    Skeleton segments;
+};
@@ -0,0 +1,255 @@
+#include "PrimitiveBatch.h"
+#include "Profiler.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// same segment count raylib uses for DrawCircleV
+static constexpr int kCircleSegments = 36;
+
+static const std::array<Vector2, kCircleSegments + 1> &unitCircle()
+{
+    static const auto mesh = []
+    {
+        std::array<Vector2, kCircleSegments + 1> m;
+        for (int i = 0; i <= kCircleSegments; ++i)
+        {
+            float a = 2 * PI * i / kCircleSegments;
+            m[i] = {cosf(a), sinf(a)};
+        }
+        return m;
+    }();
+    return mesh;
+}
+
+void InstanceMesh::addTriangle(Vector2 b0, Vector2 o0, Vector2 b1, Vector2 o1, Vector2 b2, Vector2 o2)
+{
+    // orient for a unit-scale instance; a positive scale keeps the winding
+    Vector2 p0 = {b0.x + o0.x, b0.y + o0.y}, p1 = {b1.x + o1.x, b1.y + o1.y}, p2 = {b2.x + o2.x, b2.y + o2.y};
+    float cross = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+    if (cross > 0)
+    {
+        std::swap(b1, b2);
+        std::swap(o1, o2);
+    }
+    base.insert(base.end(), {b0, b1, b2});
+    offset.insert(offset.end(), {o0, o1, o2});
+}
+
+void InstanceMesh::addLine(Vector2 a, Vector2 b, float thick)
+{
+    float dx = b.x - a.x, dy = b.y - a.y;
+    float len = sqrtf(dx * dx + dy * dy);
+    if (len <= 0.0f)
+        return;
+    Vector2 n = {-dy / len * thick * 0.5f, dx / len * thick * 0.5f};
+    Vector2 m = {-n.x, -n.y};
+    addTriangle(a, n, a, m, b, m);
+    addTriangle(a, n, b, m, b, n);
+}
+
+void InstanceMesh::addDot(Vector2 center, float radius)
+{
+    const auto &unit = unitCircle();
+    for (int i = 0; i < kCircleSegments; ++i)
+        addTriangle(center, {0, 0},
+                    center, {unit[i].x * radius, unit[i].y * radius},
+                    center, {unit[i + 1].x * radius, unit[i + 1].y * radius});
+}
+
+void PrimitiveBatch::setLayer(int l)
+{
+    layer = l;
+}
+
+void PrimitiveBatch::setBlendMode(int mode)
+{
+    blend = mode;
+}
+
+void PrimitiveBatch::push(Kind kind, Vector2 a, Vector2 b, float size, Color color)
+{
+    // vertex colors don't split runs, so within a layer and blend mode the
+    // primitives keep the order they were submitted in (painter's order)
+    uint64_t sequence = commands.size() & 0xffffffffu;
+    uint64_t key = (uint64_t)(layer + 32768) << 40 | (uint64_t)(blend & 0xff) << 32 | sequence;
+    commands.push_back({key, kind, color, a, b, size, 0});
+}
+
+void PrimitiveBatch::line(Vector2 a, Vector2 b, Color color)
+{
+    push(LINE, a, b, 1.0f, color);
+}
+
+void PrimitiveBatch::thickLine(Vector2 a, Vector2 b, float thick, Color color)
+{
+    push(LINE, a, b, thick, color);
+}
+
+void PrimitiveBatch::circle(Vector2 center, float radius, Color color)
+{
+    push(CIRCLE, center, center, radius, color);
+}
+
+void PrimitiveBatch::circleLines(Vector2 center, float radius, Color color)
+{
+    push(CIRCLE_LINES, center, center, radius, color);
+}
+
+void PrimitiveBatch::instances(const InstanceMesh &mesh, const Instance *items, size_t count)
+{
+    if (count > 0)
+        std::copy(items, items + count, instances(mesh, count));
+}
+
+PrimitiveBatch::Instance *PrimitiveBatch::instances(const InstanceMesh &mesh, size_t count)
+{
+    if (count == 0)
+        return nullptr;
+    // the whole group stays one contiguous command
+    push(INSTANCES, {0, 0}, {0, 0}, 0.0f, BLANK);
+    commands.back().group = static_cast<uint32_t>(instanceGroups.size());
+    instanceGroups.push_back({&mesh, instanceData.size(), count});
+    instanceData.resize(instanceData.size() + count);
+    return instanceData.data() + instanceData.size() - count;
+}
+
+// rlgl culls back faces, so every triangle is emitted counter-clockwise on screen
+void PrimitiveBatch::triangle(Vector2 p0, Vector2 p1, Vector2 p2, Color color)
+{
+    float cross = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+    if (cross > 0)
+        std::swap(p1, p2);
+    vertices.push_back({p0.x, p0.y, color});
+    vertices.push_back({p1.x, p1.y, color});
+    vertices.push_back({p2.x, p2.y, color});
+}
+
+void PrimitiveBatch::quad(Vector2 a, Vector2 b, float thick, Color color)
+{
+    float dx = b.x - a.x, dy = b.y - a.y;
+    float len = sqrtf(dx * dx + dy * dy);
+    if (len <= 0.0f)
+        return;
+    float nx = -dy / len * thick * 0.5f, ny = dx / len * thick * 0.5f;
+
+    Vector2 p0 = {a.x + nx, a.y + ny}, p1 = {a.x - nx, a.y - ny};
+    Vector2 p2 = {b.x - nx, b.y - ny}, p3 = {b.x + nx, b.y + ny};
+    triangle(p0, p1, p2, color);
+    triangle(p0, p2, p3, color);
+}
+
+const PrimitiveBatch::Stats &PrimitiveBatch::build()
+{
+    std::sort(commands.begin(), commands.end(),
+              [](const Command &l, const Command &r)
+              { return l.key < r.key; });
+
+    const auto &unit = unitCircle();
+    vertices.clear();
+    runs.clear();
+
+    for (const Command &c : commands)
+    {
+        size_t before = vertices.size();
+        switch (c.kind)
+        {
+        case LINE:
+            quad(c.a, c.b, c.size, c.color);
+            break;
+        case CIRCLE:
+            for (int i = 0; i < kCircleSegments; ++i)
+                triangle(c.a,
+                         {c.a.x + unit[i].x * c.size, c.a.y + unit[i].y * c.size},
+                         {c.a.x + unit[i + 1].x * c.size, c.a.y + unit[i + 1].y * c.size},
+                         c.color);
+            break;
+        case CIRCLE_LINES:
+            for (int i = 0; i < kCircleSegments; ++i)
+                quad({c.a.x + unit[i].x * c.size, c.a.y + unit[i].y * c.size},
+                     {c.a.x + unit[i + 1].x * c.size, c.a.y + unit[i + 1].y * c.size},
+                     1.0f, c.color);
+            break;
+        case INSTANCES:
+        {
+            const InstanceGroup &g = instanceGroups[c.group];
+            const InstanceMesh &mesh = *g.mesh;
+            size_t n = mesh.vertexCount();
+            for (size_t k = g.first; k < g.first + g.count; ++k)
+            {
+                const Instance &in = instanceData[k];
+                for (size_t v = 0; v < n; ++v)
+                    vertices.push_back({in.pos.x + mesh.base[v].x * in.scale + mesh.offset[v].x,
+                                        in.pos.y + mesh.base[v].y * in.scale + mesh.offset[v].y,
+                                        in.color});
+            }
+            break;
+        }
+        }
+
+        // a new run only when the blend mode changes, however long it gets
+        int mode = static_cast<int>(c.key >> 32 & 0xff);
+        if (runs.empty() || runs.back().blend != mode)
+            runs.push_back({mode, before, 0});
+        runs.back().count += vertices.size() - before;
+    }
+
+    lastStats.primitives = static_cast<int>(commands.size());
+    lastStats.vertices = static_cast<int>(vertices.size());
+    lastStats.drawCalls = static_cast<int>(runs.size());
+    return lastStats;
+}
+
+void PrimitiveBatch::submit() const
+{
+    int current = BLEND_ALPHA;
+    for (const Run &run : runs)
+    {
+        if (run.blend != current)
+        {
+            if (current != BLEND_ALPHA)
+                EndBlendMode();
+            if (run.blend != BLEND_ALPHA)
+                BeginBlendMode(run.blend);
+            current = run.blend;
+        }
+
+        rlBegin(RL_TRIANGLES);
+        for (size_t i = run.first; i < run.first + run.count; i += 3)
+        {
+            // a run can outgrow rlgl's vertex buffer; it then flushes the
+            // full buffer and keeps the mode, so the run stays one
+            // rlBegin/rlEnd and triangles are never cut
+            rlCheckRenderBatchLimit(3);
+            for (size_t k = i; k < i + 3; ++k)
+            {
+                const Vertex &v = vertices[k];
+                rlColor4ub(v.color.r, v.color.g, v.color.b, v.color.a);
+                rlVertex2f(v.x, v.y);
+            }
+        }
+        rlEnd();
+        // close the draw call so the counters match what the GPU sees
+        rlDrawRenderBatchActive();
+    }
+    if (current != BLEND_ALPHA)
+        EndBlendMode();
+}
+
+void PrimitiveBatch::flush()
+{
+    PROFILE_ZONE("batch.flush");
+    build();
+    submit();
+    clear();
+}
+
+void PrimitiveBatch::clear()
+{
+    commands.clear();
+    instanceGroups.clear();
+    instanceData.clear();
+    layer = 0;
+    blend = BLEND_ALPHA;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+// Shape tessellated once into triangles whose vertices are
+// base * scale + offset: `base` scales with the instance (outline points),
+// `offset` stays in pixels (line thickness, dot radius). Drawing an
+// instance is then a multiply-add per vertex with no trig.
+class InstanceMesh
+{
+public:
+    void addLine(Vector2 a, Vector2 b, float thick);
+    void addDot(Vector2 center, float radius);
+    size_t vertexCount() const { return base.size(); }
+
+private:
+    friend class PrimitiveBatch;
+    friend class SoftwareRenderer;
+    void addTriangle(Vector2 b0, Vector2 o0, Vector2 b1, Vector2 o1, Vector2 b2, Vector2 o2);
+    std::vector<Vector2> base, offset;
+};
+
+// Collects a frame's lines and circles and submits them through rlgl as
+// triangles, sorted by layer and blend mode so consecutive primitives share
+// one rlBegin/rlEnd; within those they are drawn in submission order. rlgl
+// may still flush its vertex buffer inside a long run, so the GPU can see
+// more draws than drawCalls counts.
+// Circles reuse a cached unit mesh.
+class PrimitiveBatch
+{
+public:
+    struct Instance
+    {
+        Vector2 pos;
+        float scale;
+        Color color;
+    };
+
+    struct Stats
+    {
+        int primitives = 0;
+        int vertices = 0;
+        int drawCalls = 0;
+    };
+
+    // primitives on a lower layer are always drawn first
+    void setLayer(int layer);
+    void setBlendMode(int mode);
+
+    void line(Vector2 a, Vector2 b, Color color);
+    void thickLine(Vector2 a, Vector2 b, float thick, Color color);
+    void circle(Vector2 center, float radius, Color color);
+    void circleLines(Vector2 center, float radius, Color color);
+    // many copies of a cached mesh as one command; build() expands them on
+    // the CPU into the surrounding run, so they cost no extra submission
+    void instances(const InstanceMesh &mesh, const Instance *items, size_t count);
+    // same, but the caller fills the returned `count` items in place; the
+    // pointer is valid until the next call that adds to the batch
+    Instance *instances(const InstanceMesh &mesh, size_t count);
+
+    // build() sorts and tessellates into the vertex buffer, submit() hands
+    // it to rlgl; flush() does both and clears the batch
+    const Stats &build();
+    void submit() const;
+    void flush();
+    void clear();
+
+    const Stats &stats() const { return lastStats; }
+    size_t size() const { return commands.size(); }
+
+private:
+    friend class SoftwareRenderer;
+
+    enum Kind : uint8_t
+    {
+        LINE,
+        CIRCLE,
+        CIRCLE_LINES,
+        INSTANCES
+    };
+
+    struct Command
+    {
+        uint64_t key; // layer | blend | submission index, the sort order
+        Kind kind;
+        Color color;
+        Vector2 a, b;
+        float size;     // radius or thickness
+        uint32_t group; // index into instanceGroups for INSTANCES
+    };
+
+    struct InstanceGroup
+    {
+        const InstanceMesh *mesh;
+        size_t first, count;
+    };
+
+    struct Vertex
+    {
+        float x, y;
+        Color color;
+    };
+
+    // a contiguous vertex range drawn with one blend mode
+    struct Run
+    {
+        int blend;
+        size_t first, count;
+    };
+
+    void push(Kind kind, Vector2 a, Vector2 b, float size, Color color);
+    void triangle(Vector2 p0, Vector2 p1, Vector2 p2, Color color);
+    void quad(Vector2 a, Vector2 b, float thick, Color color);
+
+    int layer = 0;
+    int blend = BLEND_ALPHA;
+    std::vector<Command> commands;
+    std::vector<Vertex> vertices;
+    std::vector<Run> runs;
+    std::vector<InstanceGroup> instanceGroups;
+    std::vector<Instance> instanceData;
+    Stats lastStats;
+};
@@ -0,0 +1,274 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace profiler
+{
+    std::atomic<bool> gEnabled{false};
+    thread_local int tlsDepth = 0;
+
+    namespace
+    {
+        struct Event
+        {
+            const char *name;
+            int64_t start, end;
+            int depth;
+        };
+
+        // an Event as its ring stores it: other threads read slots while the
+        // owner may be overwriting them, so every field is an atomic (plain
+        // moves on x86 with relaxed order)
+        struct Slot
+        {
+            std::atomic<const char *> name;
+            std::atomic<int64_t> start, end;
+            std::atomic<int> depth;
+        };
+
+        // written only by its thread; `head` is published with release so
+        // readers see every event below it. Slot i is rewritten once head
+        // reaches i + kCapacity, see readEvent().
+        struct ThreadBuffer
+        {
+            static constexpr uint64_t kCapacity = 1 << 15;
+            Slot events[kCapacity];
+            std::atomic<uint64_t> head{0};
+            uint64_t cursor = 0; // next event frameMark() has not folded in
+            int id = 0;
+            char name[32] = {};
+        };
+
+        // zones with the window's running totals, folded into Summary
+        struct Accum
+        {
+            const char *name;
+            int depth;
+            int64_t total, longest;
+            long calls;
+        };
+
+        constexpr int kWindowFrames = 30;
+
+        const int64_t epochNs = nowNs();
+
+        // buffers are never freed, so a trace still has the events of
+        // threads that already exited (job workers, the simulation thread)
+        std::mutex registryLock;
+        std::vector<ThreadBuffer *> &registry()
+        {
+            static std::vector<ThreadBuffer *> buffers;
+            return buffers;
+        }
+        thread_local ThreadBuffer *tlsBuffer = nullptr;
+
+        ThreadBuffer &threadBuffer()
+        {
+            if (!tlsBuffer)
+            {
+                ThreadBuffer *b = new ThreadBuffer();
+                std::lock_guard<std::mutex> guard(registryLock);
+                b->id = static_cast<int>(registry().size());
+                std::snprintf(b->name, sizeof(b->name), "thread %d", b->id);
+                registry().push_back(b);
+                tlsBuffer = b;
+            }
+            return *tlsBuffer;
+        }
+
+        // frameMark() state, main thread only
+        Accum accum[kMaxZones];
+        int accumCount = 0;
+        int windowFrames = 0;
+        int64_t lastFrameNs = 0;
+        float history[kFrameHistory] = {};
+        int historyNext = 0;
+        Summary shown;
+
+        void fold(const Event &e)
+        {
+            int i = 0;
+            while (i < accumCount && accum[i].name != e.name && std::strcmp(accum[i].name, e.name) != 0)
+                ++i;
+            if (i == accumCount)
+            {
+                if (accumCount == kMaxZones)
+                    return;
+                accum[accumCount++] = {e.name, e.depth, 0, 0, 0};
+            }
+            Accum &a = accum[i];
+            int64_t d = e.end - e.start;
+            a.depth = std::min(a.depth, e.depth);
+            a.total += d;
+            a.longest = std::max(a.longest, d);
+            ++a.calls;
+        }
+
+        // readers keep this far from the slots the owner is about to reuse,
+        // so a copy is rarely thrown away
+        constexpr uint64_t kReadMargin = ThreadBuffer::kCapacity / 8;
+
+        // oldest event worth reading, and one past the newest
+        void liveRange(const ThreadBuffer &b, uint64_t &first, uint64_t &last)
+        {
+            last = b.head.load(std::memory_order_acquire);
+            uint64_t keep = ThreadBuffer::kCapacity - kReadMargin;
+            first = last > keep ? last - keep : 0;
+        }
+
+        // Copies event i, false if the owner may have overwritten it
+        // meanwhile. The owner fences (release) before filling a slot, so a
+        // copy that saw any of the new fields also sees the head that
+        // rewrite started from.
+        bool readEvent(const ThreadBuffer &b, uint64_t i, Event &out)
+        {
+            const Slot &s = b.events[i & (ThreadBuffer::kCapacity - 1)];
+            out.name = s.name.load(std::memory_order_relaxed);
+            out.start = s.start.load(std::memory_order_relaxed);
+            out.end = s.end.load(std::memory_order_relaxed);
+            out.depth = s.depth.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return b.head.load(std::memory_order_relaxed) < i + ThreadBuffer::kCapacity;
+        }
+
+        double toUs(int64_t ns) { return (ns - epochNs) / 1000.0; }
+    }
+
+    void setEnabled(bool on)
+    {
+        gEnabled.store(on, std::memory_order_relaxed);
+    }
+
+    bool enabled()
+    {
+        return gEnabled.load(std::memory_order_relaxed);
+    }
+
+    void record(const char *name, int64_t startNs, int64_t endNs, int depth)
+    {
+        ThreadBuffer &b = threadBuffer();
+        uint64_t h = b.head.load(std::memory_order_relaxed);
+        Slot &s = b.events[h & (ThreadBuffer::kCapacity - 1)];
+        std::atomic_thread_fence(std::memory_order_release); // pairs with readEvent()
+        s.name.store(name, std::memory_order_relaxed);
+        s.start.store(startNs, std::memory_order_relaxed);
+        s.end.store(endNs, std::memory_order_relaxed);
+        s.depth.store(depth, std::memory_order_relaxed);
+        b.head.store(h + 1, std::memory_order_release);
+    }
+
+    void setThreadName(const char *name)
+    {
+        ThreadBuffer &b = threadBuffer();
+        std::lock_guard<std::mutex> guard(registryLock);
+        std::snprintf(b.name, sizeof(b.name), "%s", name);
+    }
+
+    void frameMark()
+    {
+        {
+            std::lock_guard<std::mutex> guard(registryLock);
+            for (ThreadBuffer *b : registry())
+            {
+                uint64_t first, last;
+                liveRange(*b, first, last);
+                Event e;
+                for (uint64_t i = std::max(b->cursor, first); i < last; ++i)
+                    if (readEvent(*b, i, e))
+                        fold(e);
+                b->cursor = last;
+            }
+        }
+
+        int64_t now = nowNs();
+        if (lastFrameNs != 0)
+        {
+            history[historyNext] = (now - lastFrameNs) / 1e6f;
+            historyNext = (historyNext + 1) % kFrameHistory;
+        }
+        lastFrameNs = now;
+
+        shown.maxFrameMs = 0.0f;
+        for (int i = 0; i < kFrameHistory; ++i)
+        {
+            shown.frameMs[i] = history[(historyNext + i) % kFrameHistory];
+            shown.maxFrameMs = std::max(shown.maxFrameMs, shown.frameMs[i]);
+        }
+        shown.lastFrameMs = shown.frameMs[kFrameHistory - 1];
+
+        if (++windowFrames < kWindowFrames)
+            return;
+        shown.zoneCount = accumCount;
+        shown.frames = windowFrames;
+        for (int i = 0; i < accumCount; ++i)
+        {
+            ZoneStats &z = shown.zones[i];
+            z.name = accum[i].name;
+            z.depth = accum[i].depth;
+            z.msPerFrame = accum[i].total / 1e6 / windowFrames;
+            z.maxMs = accum[i].longest / 1e6;
+            z.calls = static_cast<double>(accum[i].calls) / windowFrames;
+        }
+        accumCount = 0;
+        windowFrames = 0;
+    }
+
+    const Summary &summary()
+    {
+        return shown;
+    }
+
+    bool writeChromeTrace(const char *path)
+    {
+        FILE *f = std::fopen(path, "w");
+        if (!f)
+            return false;
+        std::lock_guard<std::mutex> guard(registryLock);
+        std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        bool first = true;
+        for (const ThreadBuffer *b : registry())
+        {
+            std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                         first ? "" : ",\n", b->id, b->name);
+            first = false;
+            uint64_t begin, end;
+            liveRange(*b, begin, end);
+            Event e;
+            for (uint64_t i = begin; i < end; ++i)
+            {
+                if (!readEvent(*b, i, e))
+                    continue;
+                std::fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                             e.name, b->id, toUs(e.start), (e.end - e.start) / 1000.0);
+            }
+        }
+        std::fprintf(f, "\n]}\n");
+        return std::fclose(f) == 0;
+    }
+
+    bool writeCsv(const char *path)
+    {
+        FILE *f = std::fopen(path, "w");
+        if (!f)
+            return false;
+        std::lock_guard<std::mutex> guard(registryLock);
+        std::fprintf(f, "thread,zone,depth,start_us,duration_us\n");
+        for (const ThreadBuffer *b : registry())
+        {
+            uint64_t begin, end;
+            liveRange(*b, begin, end);
+            Event e;
+            for (uint64_t i = begin; i < end; ++i)
+            {
+                if (!readEvent(*b, i, e))
+                    continue;
+                std::fprintf(f, "%s,%s,%d,%.3f,%.3f\n",
+                             b->name, e.name, e.depth, toUs(e.start), (e.end - e.start) / 1000.0);
+            }
+        }
+        return std::fclose(f) == 0;
+    }
+}
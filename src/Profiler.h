@@ -0,0 +1,109 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Scoped timing zones for finding where a frame's time goes.
+//
+//   PROFILE_ZONE("update");   // times the rest of the enclosing scope
+//   PROFILE_FRAME();          // once per rendered frame, on the main thread
+//   PROFILE_THREAD("sim");    // names the calling thread in traces
+//
+// Each thread records into its own fixed ring of events, so recording
+// never locks or allocates after a thread's first zone. Zones only record
+// while profiler::setEnabled(true); off, a zone costs one load and branch.
+// With the OOCATCHER_PROFILE CMake option off the macros expand to nothing
+// and the functions below see no events.
+//
+// Zone names must be string literals: events keep the pointer.
+namespace profiler
+{
+    struct ZoneStats
+    {
+        const char *name = nullptr;
+        int depth = 0;       // shallowest nesting the zone was seen at
+        double msPerFrame = 0.0;
+        double maxMs = 0.0;  // longest single call
+        double calls = 0.0;  // per frame
+    };
+
+    constexpr int kMaxZones = 32;
+    constexpr int kFrameHistory = 240;
+
+    struct Summary
+    {
+        ZoneStats zones[kMaxZones];
+        int zoneCount = 0;
+        int frames = 0;                  // frames the zone figures average over
+        float frameMs[kFrameHistory] = {}; // oldest first
+        float lastFrameMs = 0.0f;
+        float maxFrameMs = 0.0f;
+    };
+
+    void setEnabled(bool on);
+    bool enabled();
+
+    // closes the frame: folds the events recorded since the last call into
+    // the running per-zone totals and records the frame time
+    void frameMark();
+    // per-zone averages over the last completed window of frames
+    const Summary &summary();
+
+    // writes the events still in the rings, less the oldest eighth that the
+    // recording threads may be about to reuse, as a Chrome trace_event JSON
+    // (chrome://tracing, Perfetto) or as CSV; false if the file can't be written
+    bool writeChromeTrace(const char *path);
+    bool writeCsv(const char *path);
+
+    // ---- recording, used through the macros ----
+
+    inline int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    void record(const char *name, int64_t startNs, int64_t endNs, int depth);
+    void setThreadName(const char *name);
+
+    extern std::atomic<bool> gEnabled;
+    extern thread_local int tlsDepth;
+
+    class Zone
+    {
+    public:
+        explicit Zone(const char *name) : name(name)
+        {
+            if (gEnabled.load(std::memory_order_relaxed))
+            {
+                start = nowNs();
+                ++tlsDepth;
+            }
+        }
+        ~Zone()
+        {
+            if (start >= 0)
+                record(name, start, nowNs(), --tlsDepth);
+        }
+
+        Zone(const Zone &) = delete;
+        Zone &operator=(const Zone &) = delete;
+
+    private:
+        const char *name;
+        int64_t start = -1;
+    };
+}
+
+#ifdef OOCATCHER_PROFILE
+#define PROFILE_JOIN2(a, b) a##b
+#define PROFILE_JOIN(a, b) PROFILE_JOIN2(a, b)
+#define PROFILE_ZONE(name) ::profiler::Zone PROFILE_JOIN(profileZone_, __LINE__)(name)
+#define PROFILE_FRAME() ::profiler::frameMark()
+#define PROFILE_THREAD(name) ::profiler::setThreadName(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+
+// splitmix64: a well-mixed 64-bit value for any input
+inline uint64_t splitmix64(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// xoshiro256**: small, fast and fully determined by its seed, so a game
+// seeded the same way makes the same draws on every run and platform
+class Rng
+{
+public:
+    explicit Rng(uint64_t seed = 1) { reseed(seed); }
+
+    void reseed(uint64_t seed)
+    {
+        for (uint64_t &w : s)
+            w = seed = splitmix64(seed);
+    }
+
+    uint64_t next()
+    {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // uniform in [0, n) for n > 0 (multiply-shift, no division)
+    int below(int n)
+    {
+        return static_cast<int>(((next() >> 32) * static_cast<uint64_t>(n)) >> 32);
+    }
+
+    // uniform in [0, 1)
+    float unit()
+    {
+        return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f);
+    }
+
+    const uint64_t *state() const { return s; }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t s[4];
+};
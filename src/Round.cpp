@@ -0,0 +1,34 @@
+#include "Round.h"
+#include <cmath>
+
+namespace rounds
+{
+    static const Color kColors[] = {RED, ORANGE, VIOLET, GREEN, BLUE, GOLD, DARKPURPLE, PINK, BROWN};
+    static constexpr int kColorCount = static_cast<int>(sizeof kColors / sizeof kColors[0]);
+    static constexpr int kMaxHeight = 200; // a ball's highest rest above the ground
+
+    long maxTicks(float tickDt)
+    {
+        return std::lround(kMaxSeconds / tickDt);
+    }
+
+    Ball randomBall(Rng &rng, float startX, int screenW, float groundY)
+    {
+        float r = 16.0f + rng.below(18);
+        float x = startX + 300 + rng.below(screenW - 500);
+        int minY = static_cast<int>(groundY - r - kMaxHeight);
+        int maxY = static_cast<int>(groundY - r);
+        float y = static_cast<float>(minY + rng.below(maxY - minY + 1));
+        Color c = kColors[rng.below(kColorCount)];
+        return Ball({x, y}, r, c);
+    }
+
+    Target randomTarget(Rng &rng, float left, int screenW, float groundY)
+    {
+        float x = left + 100 + rng.below(screenW - 200);
+        float y = 100 + rng.below(static_cast<int>(groundY - 200));
+        float r = 22.0f + rng.below(15);
+        Color c = kColors[rng.below(kColorCount)];
+        return Target({x, y}, r, c);
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "Ball.h"
+#include "Rng.h"
+#include "Target.h"
+
+// How a round of the game is laid out and timed: where the ball and the
+// target go, how long the headless autopilot plays one, and the physics
+// it is played with. Game, CrowdScene, the throw tuner (tune/) and the
+// benches all draw their rounds from here, so the same generator state
+// gives them the same layout.
+namespace rounds
+{
+    constexpr int kScreenW = 900, kScreenH = 600;
+    constexpr float kGroundY = 500.0f;
+    constexpr float kStartX = 100.0f;    // where the first round's walker starts
+    constexpr float kTickRate = 60.0f;   // default fixed simulation tick, Hz
+    constexpr float kMaxSeconds = 15.0f; // the headless autopilot gives up on a round after this
+    constexpr float kGravity = 750.0f;          // px/s^2
+    constexpr float kFlightTime = 0.9f;         // s, a throw's flight when ThrowSolver finds none
+    constexpr float kThrowAnimDuration = 0.4f;  // s, wind-up and follow-through
+
+    // ticks the autopilot plays a round for at `tickDt` seconds per tick
+    long maxTicks(float tickDt);
+
+    // a ball 300 px or more right of startX, resting on the ground or up
+    // to 200 px above it, in one of the round colors
+    Ball randomBall(Rng &rng, float startX, int screenW, float groundY);
+    // a target inside the screen whose left edge is at `left`
+    Target randomTarget(Rng &rng, float left, int screenW, float groundY);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+// Thin wrapper over the widest float vector the compiler targets, so batch
+// kernels are written once. OOCATCHER_SIMD is defined when one is available;
+// otherwise callers keep to their scalar loops.
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#define OOCATCHER_SIMD 1
+#include <immintrin.h>
+#include <cstdint>
+
+namespace simd
+{
+#if defined(__AVX2__)
+    struct Ops
+    {
+        using V = __m256;
+        using I = __m256i;
+        static constexpr int width = 8;
+        static constexpr const char *name = "avx2";
+        static V load(const float *p) { return _mm256_loadu_ps(p); }
+        static void store(float *p, V v) { _mm256_storeu_ps(p, v); }
+        static I loadi(const int32_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+        static void storei(int32_t *p, I v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+        static V set1(float f) { return _mm256_set1_ps(f); }
+        static I set1i(int32_t v) { return _mm256_set1_epi32(v); }
+        static V add(V a, V b) { return _mm256_add_ps(a, b); }
+        static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+        static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+        static V div(V a, V b) { return _mm256_div_ps(a, b); }
+        static V min(V a, V b) { return _mm256_min_ps(a, b); }
+        static V max(V a, V b) { return _mm256_max_ps(a, b); }
+        static V sqrt(V a) { return _mm256_sqrt_ps(a); }
+        static V andv(V a, V b) { return _mm256_and_ps(a, b); }
+        static V orv(V a, V b) { return _mm256_or_ps(a, b); }
+        static V andnot(V a, V b) { return _mm256_andnot_ps(a, b); }
+        static V xorv(V a, V b) { return _mm256_xor_ps(a, b); }
+        static V lt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static V gt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static V eqi(I a, I b) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)); }
+        static V select(V mask, V a, V b) { return _mm256_blendv_ps(b, a, mask); }
+        static I selecti(V mask, I a, I b) { return _mm256_castps_si256(select(mask, _mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+        static int movemask(V mask) { return _mm256_movemask_ps(mask); }
+        static I toInt(V a) { return _mm256_cvtps_epi32(a); }
+        static V toFloat(I a) { return _mm256_cvtepi32_ps(a); }
+        static V oddSign(I k) { return _mm256_castsi256_ps(_mm256_slli_epi32(k, 31)); }
+    };
+#else
+    struct Ops
+    {
+        using V = __m128;
+        using I = __m128i;
+        static constexpr int width = 4;
+        static constexpr const char *name = "sse2";
+        static V load(const float *p) { return _mm_loadu_ps(p); }
+        static void store(float *p, V v) { _mm_storeu_ps(p, v); }
+        static I loadi(const int32_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+        static void storei(int32_t *p, I v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+        static V set1(float f) { return _mm_set1_ps(f); }
+        static I set1i(int32_t v) { return _mm_set1_epi32(v); }
+        static V add(V a, V b) { return _mm_add_ps(a, b); }
+        static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+        static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+        static V div(V a, V b) { return _mm_div_ps(a, b); }
+        static V min(V a, V b) { return _mm_min_ps(a, b); }
+        static V max(V a, V b) { return _mm_max_ps(a, b); }
+        static V sqrt(V a) { return _mm_sqrt_ps(a); }
+        static V andv(V a, V b) { return _mm_and_ps(a, b); }
+        static V orv(V a, V b) { return _mm_or_ps(a, b); }
+        static V andnot(V a, V b) { return _mm_andnot_ps(a, b); }
+        static V xorv(V a, V b) { return _mm_xor_ps(a, b); }
+        static V lt(V a, V b) { return _mm_cmplt_ps(a, b); }
+        static V gt(V a, V b) { return _mm_cmpgt_ps(a, b); }
+        static V eqi(I a, I b) { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
+        static V select(V mask, V a, V b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+        static I selecti(V mask, I a, I b) { return _mm_castps_si128(select(mask, _mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+        static int movemask(V mask) { return _mm_movemask_ps(mask); }
+        static I toInt(V a) { return _mm_cvtps_epi32(a); }
+        static V toFloat(I a) { return _mm_cvtepi32_ps(a); }
+        static V oddSign(I k) { return _mm_castsi128_ps(_mm_slli_epi32(k, 31)); }
+    };
+#endif
+}
+
+#endif
@@ -0,0 +1,50 @@
+#include "Skeleton.h"
+#include <algorithm>
+#include <cmath>
+
+int Skeleton::add(float length, float minAngle, float maxAngle, int parent)
+{
+    if (parent >= static_cast<int>(segments.size()))
+        return -1;
+
+    BodySegment s;
+    s.start = {0, 0};
+    s.end = {0, -length};
+    s.length = length;
+    s.angle = 0.0f;
+    s.minAngle = minAngle;
+    s.maxAngle = maxAngle;
+    s.worldAngle = 0.0f;
+    s.parent = parent < 0 ? -1 : parent;
+    segments.push_back(s);
+    return static_cast<int>(segments.size()) - 1;
+}
+
+void Skeleton::solve()
+{
+    BodySegment *s = segments.data();
+    for (size_t i = 0, n = segments.size(); i < n; ++i)
+    {
+        BodySegment &seg = s[i];
+        seg.angle = std::clamp(seg.angle, seg.minAngle, seg.maxAngle);
+        if (seg.parent >= 0)
+        {
+            const BodySegment &p = s[seg.parent];
+            seg.start = p.end;
+            seg.worldAngle = p.worldAngle + seg.angle;
+        }
+        else
+            seg.worldAngle = seg.angle;
+
+        float rad = DEG2RAD * seg.worldAngle;
+        seg.end = {
+            seg.start.x + cosf(rad) * seg.length,
+            seg.start.y + sinf(rad) * seg.length};
+    }
+}
+
+void Skeleton::draw(PrimitiveBatch &batch, Color color) const
+{
+    for (const BodySegment &s : segments)
+        batch.line(s.start, s.end, color);
+}
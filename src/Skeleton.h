@@ -0,0 +1,45 @@
+#pragma once
+#include "raylib.h"
+#include "BodySegment.h"
+#include "PrimitiveBatch.h"
+#include "SmallVector.h"
+
+// Bones stored in one contiguous array in parent-before-child order.
+//
+// add() only accepts parents that already exist, so the order holds by
+// construction and solve() runs forward kinematics in a single linear
+// pass: every parent's end point is final by the time its children read
+// it. Joint limits are applied during the pass.
+//
+// Up to kInlineSegments bones live inside the Skeleton itself, so a walker
+// is built, copied and reset without touching the heap.
+class Skeleton
+{
+public:
+    static constexpr size_t kInlineSegments = 16;
+
+    // returns the new segment's index, or -1 if parent does not exist yet
+    int add(float length, float minAngle, float maxAngle, int parent = -1);
+    void clear() { segments.clear(); }
+    void reserve(size_t count) { segments.reserve(count); }
+
+    // start point of a root segment; children start at their parent's end
+    void setRoot(int i, Vector2 start) { segments[i].start = start; }
+    void setAngle(int i, float degrees) { segments[i].angle = degrees; }
+    void setLength(int i, float length) { segments[i].length = length; }
+
+    // clamps every angle to [minAngle, maxAngle] and places all segments
+    void solve();
+
+    size_t size() const { return segments.size(); }
+    bool empty() const { return segments.empty(); }
+    BodySegment &operator[](size_t i) { return segments[i]; }
+    const BodySegment &operator[](size_t i) const { return segments[i]; }
+    const BodySegment *begin() const { return segments.begin(); }
+    const BodySegment *end() const { return segments.end(); }
+
+    void draw(PrimitiveBatch &batch, Color color) const;
+
+private:
+    SmallVector<BodySegment, kInlineSegments> segments;
+};
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+// Vector of trivially copyable T that keeps its first N elements inside
+// the object and only goes to the heap beyond that. Entities whose data
+// fits in N (a walker's bones, a ball's impacts) can be created, copied
+// and reset without allocating.
+template <class T, size_t N>
+class SmallVector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector copies elements with memcpy");
+
+public:
+    SmallVector() = default;
+    SmallVector(const SmallVector &other) { assign(other); }
+    SmallVector &operator=(const SmallVector &other)
+    {
+        if (this != &other)
+            assign(other);
+        return *this;
+    }
+    // a heap buffer changes owner; inline elements are copied
+    SmallVector(SmallVector &&other) noexcept { take(other); }
+    SmallVector &operator=(SmallVector &&other) noexcept
+    {
+        if (this != &other)
+            take(other);
+        return *this;
+    }
+
+    void push_back(const T &value)
+    {
+        if (count == capacity())
+            grow(count * 2);
+        data()[count++] = value;
+    }
+    void clear() { count = 0; }
+    void reserve(size_t n)
+    {
+        if (n > capacity())
+            grow(n);
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t capacity() const { return heap ? heapCapacity : N; }
+    bool onHeap() const { return heap != nullptr; }
+
+    T *data() { return heap ? heap.get() : local; }
+    const T *data() const { return heap ? heap.get() : local; }
+    T &operator[](size_t i) { return data()[i]; }
+    const T &operator[](size_t i) const { return data()[i]; }
+    T &back() { return data()[count - 1]; }
+    T *begin() { return data(); }
+    T *end() { return data() + count; }
+    const T *begin() const { return data(); }
+    const T *end() const { return data() + count; }
+
+private:
+    void grow(size_t n)
+    {
+        std::unique_ptr<T[]> bigger(new T[n]);
+        std::memcpy(bigger.get(), data(), count * sizeof(T));
+        heap = std::move(bigger);
+        heapCapacity = n;
+    }
+
+    void assign(const SmallVector &other)
+    {
+        count = 0;
+        reserve(other.count);
+        std::memcpy(data(), other.data(), other.count * sizeof(T));
+        count = other.count;
+    }
+
+    void take(SmallVector &other) noexcept
+    {
+        if (other.heap)
+        {
+            heap = std::move(other.heap);
+            heapCapacity = other.heapCapacity;
+            other.heapCapacity = 0;
+        }
+        else
+        {
+            heap.reset();
+            heapCapacity = 0;
+            std::memcpy(local, other.local, other.count * sizeof(T));
+        }
+        count = other.count;
+        other.count = 0;
+    }
+
+    T local[N];
+    std::unique_ptr<T[]> heap;
+    size_t heapCapacity = 0;
+    size_t count = 0;
+};
@@ -0,0 +1,340 @@
+#include "SoftwareRenderer.h"
+#include "Profiler.h"
+#include "Simd.h"
+#include "StateHash.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// pixel centers of one run, relative to its first pixel
+alignas(32) static const float kRamp[8] = {0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f};
+
+#ifdef OOCATCHER_SIMD
+using Lanes = simd::Ops;
+
+static Lanes::V absv(Lanes::V v) { return Lanes::andnot(Lanes::set1(-0.0f), v); }
+// 1 where m >= 0, else 0
+static Lanes::V nonNegative(Lanes::V m) { return Lanes::andnot(Lanes::lt(m, Lanes::set1(0.0f)), Lanes::set1(1.0f)); }
+#else
+struct Lanes
+{
+    using V = float;
+    static constexpr int width = 1;
+    static V load(const float *p) { return *p; }
+    static void store(float *p, V v) { *p = v; }
+    static V set1(float f) { return f; }
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V min(V a, V b) { return a < b ? a : b; }
+    static V max(V a, V b) { return a > b ? a : b; }
+    static V sqrt(V a) { return sqrtf(a); }
+    static V gt(V a, V b) { return a > b ? 1.0f : 0.0f; }
+    static int movemask(V m) { return m != 0.0f; }
+};
+
+static float absv(float v) { return fabsf(v); }
+static float nonNegative(float m) { return m >= 0.0f ? 1.0f : 0.0f; }
+#endif
+
+using V = Lanes::V;
+
+// share of the pixel at (px, py) the shape covers, from its signed distance
+// where it has one
+static V coverage(const float *k, uint8_t kind, V px, V py)
+{
+    using L = Lanes;
+    const V zero = L::set1(0.0f), half = L::set1(0.5f), one = L::set1(1.0f);
+    V dx = L::sub(px, L::set1(k[0])), dy = L::sub(py, L::set1(k[1]));
+    V d;
+    switch (kind)
+    {
+    case 0: // line: a box along the segment
+    {
+        V along = L::add(L::mul(dx, L::set1(k[2])), L::mul(dy, L::set1(k[3])));
+        V across = L::sub(L::mul(dy, L::set1(k[2])), L::mul(dx, L::set1(k[3])));
+        V outside = L::max(L::sub(zero, along), L::sub(along, L::set1(k[4])));
+        d = L::max(outside, L::sub(absv(across), L::set1(k[5])));
+        break;
+    }
+    case 1: // circle
+        d = L::sub(L::sqrt(L::add(L::mul(dx, dx), L::mul(dy, dy))), L::set1(k[2]));
+        break;
+    case 2: // ring
+        d = L::sub(absv(L::sub(L::sqrt(L::add(L::mul(dx, dx), L::mul(dy, dy))), L::set1(k[2]))), L::set1(k[3]));
+        break;
+    default: // triangle: inside all three edges, no antialiasing
+    {
+        auto edge = [&](int a, int b)
+        {
+            V ex = L::set1(k[b] - k[a]), ey = L::set1(k[b + 1] - k[a + 1]);
+            V rx = L::sub(px, L::set1(k[a])), ry = L::sub(py, L::set1(k[a + 1]));
+            return L::sub(L::mul(ex, ry), L::mul(ey, rx));
+        };
+        return nonNegative(L::min(L::min(edge(0, 2), edge(2, 4)), edge(4, 0)));
+    }
+    }
+    return L::min(L::max(L::sub(half, d), zero), one);
+}
+
+const char *SoftwareRenderer::simdName()
+{
+#ifdef OOCATCHER_SIMD
+    return simd::Ops::name;
+#else
+    return "scalar";
+#endif
+}
+
+SoftwareRenderer::SoftwareRenderer(int width, int height)
+    : w(std::max(width, 1)), h(std::max(height, 1))
+{
+    tilesX = (w + kTile - 1) / kTile;
+    tilesY = (h + kTile - 1) / kTile;
+    stride = tilesX * kTile;
+    rows = tilesY * kTile;
+    red.assign(static_cast<size_t>(stride) * rows, 0.0f);
+    green.assign(red.size(), 0.0f);
+    blue.assign(red.size(), 0.0f);
+    binStart.assign(static_cast<size_t>(tilesX) * tilesY + 1, 0);
+    image.resize(static_cast<size_t>(w) * h * 3);
+    camera = {};
+    camera.zoom = 1.0f;
+}
+
+void SoftwareRenderer::clear(Color color)
+{
+    std::fill(red.begin(), red.end(), color.r / 255.0f);
+    std::fill(green.begin(), green.end(), color.g / 255.0f);
+    std::fill(blue.begin(), blue.end(), color.b / 255.0f);
+}
+
+void SoftwareRenderer::setCamera(const Camera2D &c)
+{
+    camera = c;
+}
+
+Vector2 SoftwareRenderer::toScreen(Vector2 p) const
+{
+    return {(p.x - camera.target.x) * camera.zoom + camera.offset.x,
+            (p.y - camera.target.y) * camera.zoom + camera.offset.y};
+}
+
+// clips the shape's bounds, plus a pixel for the antialiased edge, to the image
+void SoftwareRenderer::add(Shape s, float minX, float minY, float maxX, float maxY)
+{
+    s.x0 = std::max(static_cast<int>(std::floor(minX)) - 1, 0);
+    s.y0 = std::max(static_cast<int>(std::floor(minY)) - 1, 0);
+    s.x1 = std::min(static_cast<int>(std::ceil(maxX)) + 1, w);
+    s.y1 = std::min(static_cast<int>(std::ceil(maxY)) + 1, h);
+    if (s.x0 < s.x1 && s.y0 < s.y1 && s.a > 0.0f)
+        shapes.push_back(s);
+}
+
+void SoftwareRenderer::addCommand(const PrimitiveBatch &batch, const PrimitiveBatch::Command &c)
+{
+    Shape s = {};
+    s.additive = (c.key >> 32 & 0xff) == BLEND_ADDITIVE;
+    auto paint = [&s](Color color)
+    {
+        s.r = color.r / 255.0f;
+        s.g = color.g / 255.0f;
+        s.b = color.b / 255.0f;
+        s.a = color.a / 255.0f;
+    };
+    paint(c.color);
+    const float zoom = camera.zoom;
+
+    switch (c.kind)
+    {
+    case PrimitiveBatch::LINE:
+    {
+        Vector2 a = toScreen(c.a), b = toScreen(c.b);
+        float dx = b.x - a.x, dy = b.y - a.y, len = sqrtf(dx * dx + dy * dy), hw = c.size * zoom * 0.5f;
+        if (len <= 0.0f)
+            return;
+        s.kind = SHAPE_LINE;
+        float k[6] = {a.x, a.y, dx / len, dy / len, len, hw};
+        std::memcpy(s.k, k, sizeof k);
+        add(s, std::min(a.x, b.x) - hw, std::min(a.y, b.y) - hw, std::max(a.x, b.x) + hw, std::max(a.y, b.y) + hw);
+        break;
+    }
+    case PrimitiveBatch::CIRCLE:
+    case PrimitiveBatch::CIRCLE_LINES:
+    {
+        Vector2 p = toScreen(c.a);
+        float r = c.size * zoom, hw = 0.5f * zoom;
+        s.kind = c.kind == PrimitiveBatch::CIRCLE ? SHAPE_CIRCLE : SHAPE_RING;
+        float k[6] = {p.x, p.y, r, hw, 0.0f, 0.0f};
+        std::memcpy(s.k, k, sizeof k);
+        float reach = s.kind == SHAPE_RING ? r + hw : r;
+        add(s, p.x - reach, p.y - reach, p.x + reach, p.y + reach);
+        break;
+    }
+    case PrimitiveBatch::INSTANCES:
+    {
+        const PrimitiveBatch::InstanceGroup &g = batch.instanceGroups[c.group];
+        const InstanceMesh &mesh = *g.mesh;
+        s.kind = SHAPE_TRIANGLE;
+        for (size_t i = g.first; i < g.first + g.count; ++i)
+        {
+            const PrimitiveBatch::Instance &in = batch.instanceData[i];
+            paint(in.color);
+            for (size_t v = 0; v + 2 < mesh.vertexCount(); v += 3)
+            {
+                Vector2 p[3];
+                for (int j = 0; j < 3; ++j)
+                    p[j] = toScreen({in.pos.x + mesh.base[v + j].x * in.scale + mesh.offset[v + j].x,
+                                     in.pos.y + mesh.base[v + j].y * in.scale + mesh.offset[v + j].y});
+                float cross = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+                if (cross == 0.0f)
+                    continue;
+                if (cross < 0.0f)
+                    std::swap(p[1], p[2]);
+                float k[6] = {p[0].x, p[0].y, p[1].x, p[1].y, p[2].x, p[2].y};
+                std::memcpy(s.k, k, sizeof k);
+                add(s, std::min({p[0].x, p[1].x, p[2].x}), std::min({p[0].y, p[1].y, p[2].y}),
+                    std::max({p[0].x, p[1].x, p[2].x}), std::max({p[0].y, p[1].y, p[2].y}));
+            }
+        }
+        break;
+    }
+    }
+}
+
+void SoftwareRenderer::draw(const PrimitiveBatch &batch, JobSystem &jobs)
+{
+    PROFILE_ZONE("raster");
+    shapes.clear();
+    for (const PrimitiveBatch::Command &c : batch.commands)
+        addCommand(batch, c);
+
+    // counting sort into one array, so its size depends only on how many
+    // tiles the shapes touch in total and stays put from frame to frame
+    auto forEachTile = [this](const Shape &s, auto &&visit)
+    {
+        for (int ty = s.y0 / kTile; ty <= (s.y1 - 1) / kTile; ++ty)
+            for (int tx = s.x0 / kTile; tx <= (s.x1 - 1) / kTile; ++tx)
+                visit(static_cast<size_t>(ty) * tilesX + tx);
+    };
+    std::fill(binStart.begin(), binStart.end(), 0);
+    for (const Shape &s : shapes)
+        forEachTile(s, [this](size_t tile)
+                    { ++binStart[tile + 1]; });
+    for (size_t t = 1; t < binStart.size(); ++t)
+        binStart[t] += binStart[t - 1];
+    // the total moves by a few entries as shapes cross tile edges, so it
+    // grows with room to spare
+    if (binStart.back() > binShapes.capacity())
+        binShapes.reserve(binStart.back() * 2);
+    binShapes.resize(binStart.back());
+    binFill.assign(binStart.begin(), binStart.end() - 1);
+    for (size_t i = 0; i < shapes.size(); ++i)
+        forEachTile(shapes[i], [this, i](size_t tile)
+                    { binShapes[binFill[tile]++] = static_cast<uint32_t>(i); });
+
+    jobs.parallelFor(binStart.size() - 1, 1, [this](size_t begin, size_t end)
+                     {
+                         for (size_t t = begin; t < end; ++t)
+                             fillTile(static_cast<int>(t));
+                     });
+}
+
+// every shape binned here, in order, one run of Lanes::width pixels at a
+// time; runs start on a multiple of the width, so they never leave the tile
+void SoftwareRenderer::fillTile(int tile)
+{
+    using L = Lanes;
+    const int tx0 = (tile % tilesX) * kTile, ty0 = (tile / tilesX) * kTile;
+    const V ramp = L::load(kRamp), zero = L::set1(0.0f), one = L::set1(1.0f);
+
+    for (uint32_t n = binStart[tile]; n < binStart[tile + 1]; ++n)
+    {
+        const Shape &s = shapes[binShapes[n]];
+        int xa = std::max(s.x0, tx0) / L::width * L::width, xb = std::min(s.x1, tx0 + kTile);
+        int ya = std::max(s.y0, ty0), yb = std::min(s.y1, ty0 + kTile);
+        const V r = L::set1(s.r), g = L::set1(s.g), b = L::set1(s.b), a = L::set1(s.a);
+
+        for (int y = ya; y < yb; ++y)
+        {
+            const V py = L::set1(y + 0.0f);
+            const size_t row = static_cast<size_t>(y) * stride;
+            for (int x = xa; x < xb; x += L::width)
+            {
+                V cov = coverage(s.k, s.kind, L::add(L::set1(static_cast<float>(x)), ramp), L::add(py, L::set1(0.5f)));
+                if (!L::movemask(L::gt(cov, zero)))
+                    continue;
+                V alpha = L::mul(cov, a);
+                float *pr = &red[row + x], *pg = &green[row + x], *pb = &blue[row + x];
+                if (s.additive)
+                {
+                    L::store(pr, L::min(L::add(L::load(pr), L::mul(r, alpha)), one));
+                    L::store(pg, L::min(L::add(L::load(pg), L::mul(g, alpha)), one));
+                    L::store(pb, L::min(L::add(L::load(pb), L::mul(b, alpha)), one));
+                }
+                else
+                {
+                    V dr = L::load(pr), dg = L::load(pg), db = L::load(pb);
+                    L::store(pr, L::add(dr, L::mul(L::sub(r, dr), alpha)));
+                    L::store(pg, L::add(dg, L::mul(L::sub(g, dg), alpha)));
+                    L::store(pb, L::add(db, L::mul(L::sub(b, db), alpha)));
+                }
+            }
+        }
+    }
+}
+
+static uint8_t toByte(float c)
+{
+    return static_cast<uint8_t>(std::min(std::max(c, 0.0f), 1.0f) * 255.0f + 0.5f);
+}
+
+Color SoftwareRenderer::pixel(int x, int y) const
+{
+    size_t i = static_cast<size_t>(y) * stride + x;
+    return {toByte(red[i]), toByte(green[i]), toByte(blue[i]), 255};
+}
+
+void SoftwareRenderer::rgb() const
+{
+    image.resize(static_cast<size_t>(w) * h * 3);
+    uint8_t *o = image.data();
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+        {
+            size_t i = static_cast<size_t>(y) * stride + x;
+            *o++ = toByte(red[i]);
+            *o++ = toByte(green[i]);
+            *o++ = toByte(blue[i]);
+        }
+}
+
+uint64_t SoftwareRenderer::checksum() const
+{
+    rgb();
+    StateHash hash;
+    hash.bytes(image.data(), image.size());
+    return hash.value;
+}
+
+bool SoftwareRenderer::save(const char *path) const
+{
+    size_t n = std::strlen(path);
+    if (n < 4 || std::strcmp(path + n - 4, ".png") != 0)
+        return savePpm(path);
+    rgb();
+    Image frame = {image.data(), w, h, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8};
+    return ExportImage(frame, path);
+}
+
+bool SoftwareRenderer::savePpm(const char *path) const
+{
+    rgb();
+    FILE *f = std::fopen(path, "wb");
+    if (!f)
+        return false;
+    std::fprintf(f, "P6\n%d %d\n255\n", w, h);
+    bool ok = std::fwrite(image.data(), 1, image.size(), f) == image.size();
+    return std::fclose(f) == 0 && ok;
+}
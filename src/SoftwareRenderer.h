@@ -0,0 +1,86 @@
+#pragma once
+#include "raylib.h"
+#include "JobSystem.h"
+#include "PrimitiveBatch.h"
+#include <cstdint>
+#include <vector>
+
+// CPU backend for PrimitiveBatch: rasterizes a built batch into an
+// in-memory framebuffer, so frames can be rendered, compared and saved
+// without an OpenGL context.
+//
+// Lines, circles and circle outlines are drawn from their exact shapes
+// with a pixel of antialiasing; instance meshes (the targets) are plain
+// triangles sampled at pixel centers. Each shape is binned into the
+// kTile x kTile tiles its bounds touch and the tiles are filled in
+// parallel on a JobSystem, a SIMD run of pixels at a time. Tiles never
+// share a pixel and keep the batch's order, so the image is the same for
+// any thread count. Text is not drawn.
+class SoftwareRenderer
+{
+public:
+    static constexpr int kTile = 64;
+
+    SoftwareRenderer(int width, int height);
+
+    int width() const { return w; }
+    int height() const { return h; }
+
+    void clear(Color color);
+    // maps world to screen like BeginMode2D(camera); rotation is ignored
+    void setCamera(const Camera2D &camera);
+    // draws what the last batch.build() produced over the current image
+    void draw(const PrimitiveBatch &batch, JobSystem &jobs);
+
+    Color pixel(int x, int y) const;
+    // FNV-1a over the 8-bit RGB image, for golden-image checks
+    uint64_t checksum() const;
+    // PNG for *.png (raylib's ExportImage), binary PPM otherwise; false
+    // when the file can't be written
+    bool save(const char *path) const;
+
+    // "avx2", "sse2" or "scalar"
+    static const char *simdName();
+
+private:
+    enum ShapeKind : uint8_t
+    {
+        SHAPE_LINE,
+        SHAPE_CIRCLE,
+        SHAPE_RING,
+        SHAPE_TRIANGLE
+    };
+
+    // screen-space shape with everything its coverage test needs:
+    //   line      a.x a.y dir.x dir.y length halfWidth
+    //   circle    c.x c.y radius
+    //   ring      c.x c.y radius halfWidth
+    //   triangle  x0 y0 x1 y1 x2 y2, counter-clockwise on screen
+    struct Shape
+    {
+        ShapeKind kind;
+        bool additive;
+        float r, g, b, a;
+        float k[6];
+        int x0, y0, x1, y1; // pixels covered, [x0, x1) x [y0, y1)
+    };
+
+    Vector2 toScreen(Vector2 p) const;
+    void add(Shape s, float minX, float minY, float maxX, float maxY);
+    void addCommand(const PrimitiveBatch &batch, const PrimitiveBatch::Command &c);
+    void fillTile(int tile);
+    // fills `image` with the 8-bit RGB frame
+    void rgb() const;
+    bool savePpm(const char *path) const;
+
+    int w, h;
+    int stride, rows; // padded to whole tiles
+    int tilesX, tilesY;
+    std::vector<float> red, green, blue;
+    Camera2D camera;
+    std::vector<Shape> shapes;
+    // shape indices per tile, in draw order: tile t owns
+    // binShapes[binStart[t], binStart[t + 1])
+    std::vector<uint32_t> binStart, binFill, binShapes;
+    mutable std::vector<uint8_t> image; // rgb() output, sized once
+};
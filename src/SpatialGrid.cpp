@@ -0,0 +1,174 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : cellSize(cellSize), invCellSize(1.0f / cellSize)
+{
+}
+
+SpatialGrid::CellRange SpatialGrid::cellsOf(const Circle &c) const
+{
+    return {(int)floorf((c.x - c.radius) * invCellSize), (int)floorf((c.y - c.radius) * invCellSize),
+            (int)floorf((c.x + c.radius) * invCellSize), (int)floorf((c.y + c.radius) * invCellSize)};
+}
+
+uint32_t SpatialGrid::bucketOf(int cx, int cy) const
+{
+    return ((uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u) & bucketMask;
+}
+
+int SpatialGrid::insert(const Circle &c)
+{
+    int h;
+    if (!freeList.empty())
+    {
+        h = freeList.back();
+        freeList.pop_back();
+    }
+    else
+    {
+        h = static_cast<int>(circles.size());
+        circles.emplace_back();
+        ranges.emplace_back();
+        alive.push_back(0);
+        visited.push_back(0);
+    }
+    circles[h] = c;
+    ranges[h] = cellsOf(c);
+    alive[h] = 1;
+    ++live;
+    dirty = true;
+    return h;
+}
+
+void SpatialGrid::update(int handle, const Circle &c)
+{
+    circles[handle] = c;
+    CellRange r = cellsOf(c);
+    if (r != ranges[handle])
+    {
+        ranges[handle] = r;
+        dirty = true;
+    }
+}
+
+void SpatialGrid::remove(int handle)
+{
+    alive[handle] = 0;
+    freeList.push_back(handle);
+    --live;
+    dirty = true;
+}
+
+void SpatialGrid::clear()
+{
+    circles.clear();
+    ranges.clear();
+    alive.clear();
+    visited.clear();
+    freeList.clear();
+    live = 0;
+    dirty = true;
+}
+
+// counting sort of (bucket, handle) pairs: one pass to count, a prefix sum,
+// one pass to scatter
+void SpatialGrid::rebuild() const
+{
+    uint32_t buckets = 64;
+    while (buckets < 2 * live)
+        buckets <<= 1;
+    bucketMask = buckets - 1;
+    bucketStart.assign(buckets + 1, 0);
+
+    for (size_t h = 0; h < circles.size(); ++h)
+    {
+        if (!alive[h])
+            continue;
+        const CellRange &r = ranges[h];
+        for (int cy = r.y0; cy <= r.y1; ++cy)
+            for (int cx = r.x0; cx <= r.x1; ++cx)
+                ++bucketStart[bucketOf(cx, cy) + 1];
+    }
+    for (uint32_t b = 0; b < buckets; ++b)
+        bucketStart[b + 1] += bucketStart[b];
+
+    entries.resize(bucketStart[buckets]);
+    cursor.assign(buckets, 0);
+    for (size_t h = 0; h < circles.size(); ++h)
+    {
+        if (!alive[h])
+            continue;
+        const CellRange &r = ranges[h];
+        for (int cy = r.y0; cy <= r.y1; ++cy)
+            for (int cx = r.x0; cx <= r.x1; ++cx)
+            {
+                uint32_t b = bucketOf(cx, cy);
+                entries[bucketStart[b] + cursor[b]++] = static_cast<int>(h);
+            }
+    }
+
+    visited.assign(circles.size(), 0);
+    queryStamp = 0;
+    dirty = false;
+}
+
+void SpatialGrid::beginQuery() const
+{
+    if (dirty)
+        rebuild();
+    if (++queryStamp == 0)
+    {
+        std::fill(visited.begin(), visited.end(), 0);
+        queryStamp = 1;
+    }
+}
+
+bool SpatialGrid::firstVisit(int handle) const
+{
+    if (visited[handle] == queryStamp)
+        return false;
+    visited[handle] = queryStamp;
+    return true;
+}
+
+void SpatialGrid::queryPoint(Vector2 p, std::vector<int> &out) const
+{
+    beginQuery();
+    if (live == 0)
+        return;
+
+    // two cells of one circle can hash to the same bucket, hence firstVisit
+    uint32_t b = bucketOf((int)floorf(p.x * invCellSize), (int)floorf(p.y * invCellSize));
+    for (uint32_t e = bucketStart[b]; e < bucketStart[b + 1]; ++e)
+    {
+        int h = entries[e];
+        const Circle &c = circles[h];
+        float dx = p.x - c.x, dy = p.y - c.y;
+        if (dx * dx + dy * dy <= c.radius * c.radius && firstVisit(h))
+            out.push_back(h);
+    }
+}
+
+void SpatialGrid::queryCircle(const Circle &q, std::vector<int> &out) const
+{
+    beginQuery();
+    if (live == 0)
+        return;
+
+    CellRange r = cellsOf(q);
+    for (int cy = r.y0; cy <= r.y1; ++cy)
+        for (int cx = r.x0; cx <= r.x1; ++cx)
+        {
+            uint32_t b = bucketOf(cx, cy);
+            for (uint32_t e = bucketStart[b]; e < bucketStart[b + 1]; ++e)
+            {
+                int h = entries[e];
+                const Circle &c = circles[h];
+                float dx = q.x - c.x, dy = q.y - c.y, rr = q.radius + c.radius;
+                if (dx * dx + dy * dy <= rr * rr && firstVisit(h))
+                    out.push_back(h);
+            }
+        }
+}
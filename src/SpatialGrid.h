@@ -0,0 +1,62 @@
+#pragma once
+#include "raylib.h"
+#include "Shapes.h"
+#include <cstdint>
+#include <vector>
+
+// Uniform grid over an unbounded plane, hashed into a bucket table, for
+// broadphase queries on many moving circles.
+//
+// Handles stay valid until remove(). Moving a circle within the cells it
+// already covers is free; anything that changes cell coverage marks the
+// grid dirty and the next query does one O(N) counting-sort rebuild.
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(float cellSize = 64.0f);
+
+    int insert(const Circle &c);
+    void update(int handle, const Circle &c);
+    void remove(int handle);
+    void clear();
+
+    const Circle &get(int handle) const { return circles[handle]; }
+    size_t size() const { return live; }
+
+    // rebuilds the buckets from every live circle; queries call it when needed
+    void rebuild() const;
+
+    // handles of circles containing p / overlapping c, appended to out
+    void queryPoint(Vector2 p, std::vector<int> &out) const;
+    void queryCircle(const Circle &c, std::vector<int> &out) const;
+
+private:
+    struct CellRange
+    {
+        int x0, y0, x1, y1;
+        bool operator!=(const CellRange &o) const { return x0 != o.x0 || y0 != o.y0 || x1 != o.x1 || y1 != o.y1; }
+    };
+
+    CellRange cellsOf(const Circle &c) const;
+    uint32_t bucketOf(int cx, int cy) const;
+    void beginQuery() const;
+    bool firstVisit(int handle) const;
+
+    float cellSize, invCellSize;
+    std::vector<Circle> circles;
+    std::vector<CellRange> ranges;
+    std::vector<uint8_t> alive;
+    std::vector<int> freeList;
+    size_t live = 0;
+
+    // bucket b holds entries[bucketStart[b] .. bucketStart[b + 1])
+    mutable bool dirty = false;
+    mutable uint32_t bucketMask = 0;
+    mutable std::vector<uint32_t> bucketStart;
+    mutable std::vector<int> entries;
+    mutable std::vector<uint32_t> cursor;
+
+    // de-duplicates circles that span several cells within one query
+    mutable std::vector<uint32_t> visited;
+    mutable uint32_t queryStamp = 0;
+};
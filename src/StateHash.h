@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// FNV-1a over raw bytes, for checking that two runs reached the same state
+struct StateHash
+{
+    uint64_t value = 1469598103934665603ull;
+
+    void bytes(const void *p, size_t n)
+    {
+        const unsigned char *c = static_cast<const unsigned char *>(p);
+        for (size_t k = 0; k < n; ++k)
+            value = (value ^ c[k]) * 1099511628211ull;
+    }
+
+    // trivially copyable values without padding only
+    template <class T>
+    void add(const T &v) { bytes(&v, sizeof v); }
+};
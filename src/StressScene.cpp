@@ -0,0 +1,200 @@
+#include "StressScene.h"
+#include "Profiler.h"
+#include "Rng.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+static constexpr float kLocalPerUnit = 300.0f;          // round px per world unit
+static constexpr Vector2 kLocalOrigin = {450.0f, 500.0f}; // ground center of a round
+static constexpr float kRoundHalfWidth = 450.0f;
+static constexpr float kRoundHeight = 500.0f;           // ground to the top of the round
+static constexpr float kWalkerHeight = 200.0f;          // feet to head, round px
+static constexpr float kEyeHeight = 1.0f;               // camera above the ground, world units
+static constexpr float kNearDepth = 0.5f;
+
+using StressClock = std::chrono::steady_clock;
+
+static double msSince(StressClock::time_point t)
+{
+    return std::chrono::duration<double, std::milli>(StressClock::now() - t).count();
+}
+
+StressScene::StressScene(size_t walkers, uint32_t seed, int w, int h)
+    : screenW(w), screenH(h), crowd(walkers, seed),
+      placement(walkers), scale(walkers, 0.0f), anchor(walkers, Vector2{0, 0})
+{
+    // the crowd gets deeper and wider as it grows, at roughly constant density
+    depthRange = 4.0f + 2.0f * sqrtf(static_cast<float>(walkers));
+    targets.reserve(walkers);
+    Rng rng(seed);
+    for (Vector2 &p : placement)
+        p = {(rng.unit() * 2.0f - 1.0f) * depthRange * 0.6f, 2.0f + rng.unit() * depthRange};
+}
+
+void StressScene::moveCamera(float dt, bool scripted)
+{
+    clock += dt;
+    if (scripted)
+    {
+        // dolly from the front row most of the way through and back
+        camZ = 0.4f * depthRange * (1.0f - cosf(static_cast<float>(clock) * 0.2f));
+        camX = 0.2f * depthRange * sinf(static_cast<float>(clock) * 0.13f);
+        return;
+    }
+    float speed = 0.25f * depthRange * dt;
+    if (IsKeyDown(KEY_UP) || IsKeyDown(KEY_W))    camZ += speed;
+    if (IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S))  camZ -= speed;
+    if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A))  camX -= speed;
+    if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) camX += speed;
+}
+
+// projects every round and picks its tier; a round out of view is not drawn
+// and only simulated at the coarsest rate
+void StressScene::selectDetail()
+{
+    PROFILE_ZONE("stress.lod");
+    const float focal = static_cast<float>(screenH);
+    const float horizonY = screenH * 0.35f;
+    std::fill(tierCount, tierCount + LOD_TIERS, 0);
+    offscreen = 0;
+    tierChanges = 0;
+
+    for (size_t i = 0; i < placement.size(); ++i)
+    {
+        LodTier before = crowd.detailOf(i);
+        LodTier tier = LOD_SILHOUETTE;
+        float depth = placement[i].y - camZ;
+        scale[i] = 0.0f;
+        if (depth > kNearDepth)
+        {
+            float s = focal / depth;
+            float local = s / kLocalPerUnit;
+            Vector2 at = {screenW * 0.5f + (placement[i].x - camX) * s, horizonY + kEyeHeight * s};
+            bool visible = at.x + kRoundHalfWidth * local >= 0.0f && at.x - kRoundHalfWidth * local <= screenW
+                           && at.y - kRoundHeight * local <= screenH;
+            if (visible)
+            {
+                scale[i] = local;
+                anchor[i] = at;
+                tier = policy.select(before, kWalkerHeight * local, depth);
+            }
+        }
+        if (scale[i] == 0.0f)
+            ++offscreen;
+        tierChanges += tier != before;
+        ++tierCount[tier];
+        crowd.setDetail(i, tier);
+    }
+}
+
+void StressScene::record(PrimitiveBatch &out)
+{
+    PROFILE_ZONE("stress.record");
+    const BallSystem &balls = crowd.balls();
+    auto map = [](Vector2 p, float s, Vector2 at) -> Vector2
+    { return {(p.x - kLocalOrigin.x) * s + at.x, (p.y - kLocalOrigin.y) * s + at.y}; };
+
+    targets.clear();
+    for (size_t i = 0; i < placement.size(); ++i)
+    {
+        float s = scale[i];
+        if (s == 0.0f)
+            continue;
+        LodTier tier = crowd.detailOf(i);
+        WalkerPose pose = crowd.walker(i).getPose();
+        transformPose(pose, kLocalOrigin, s, anchor[i]);
+        out.setLayer(0);
+        Walker::draw(pose, out, tier);
+        out.setLayer(1);
+        out.circle(map(balls.getPos(i), s, anchor[i]), balls.getRadius(i) * s, ORANGE);
+        if (tier <= LOD_LOW && crowd.targetActive(i))
+        {
+            const Circle &t = crowd.target(i);
+            targets.push_back(Target(map({t.x, t.y}, s, anchor[i]), t.radius * s, RED));
+        }
+    }
+    // every visible target is one instance group
+    out.setLayer(2);
+    Target::drawAll(targets.data(), targets.size(), out);
+}
+
+void StressScene::tally(StressStats &stats, double simMs, double lodMs, double drawMs) const
+{
+    // running means, so the numbers are meaningful at any point
+    double n = static_cast<double>(++stats.frames);
+    auto mean = [n](double &avg, double v)
+    { avg += (v - avg) / n; };
+    mean(stats.simMs, simMs);
+    mean(stats.lodMs, lodMs);
+    mean(stats.drawMs, drawMs);
+    stats.maxFrameMs = std::max(stats.maxFrameMs, simMs + lodMs + drawMs);
+    for (int t = 0; t < LOD_TIERS; ++t)
+        mean(stats.tiers[t], static_cast<double>(tierCount[t]));
+    mean(stats.offscreen, static_cast<double>(offscreen));
+    mean(stats.tierChanges, static_cast<double>(tierChanges));
+    stats.crowd = crowd.stats();
+}
+
+void StressScene::run(JobSystem &jobs)
+{
+    InitWindow(screenW, screenH, "OOCatcher stress");
+    SetTargetFPS(60);
+    StressStats stats;
+
+    while (!WindowShouldClose())
+    {
+        moveCamera(GetFrameTime(), false);
+        auto t0 = StressClock::now();
+        selectDetail();
+        double lodMs = msSince(t0);
+
+        auto t1 = StressClock::now();
+        crowd.step(jobs);
+        double simMs = msSince(t1);
+
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
+        DrawLine(0, static_cast<int>(screenH * 0.35f), screenW, static_cast<int>(screenH * 0.35f), LIGHTGRAY);
+        auto t2 = StressClock::now();
+        record(batch);
+        batch.flush();
+        double drawMs = msSince(t2);
+        tally(stats, simMs, lodMs, drawMs);
+
+        DrawText(TextFormat("%zu walkers  sim %.2f ms  lod %.2f ms  draw %.2f ms", size(), simMs, lodMs, drawMs),
+                 10, 10, 18, DARKGRAY);
+        DrawText(TextFormat("full %ld  medium %ld  low %ld  silhouette %ld  (off screen %ld, changed %ld)",
+                            tierCount[LOD_FULL], tierCount[LOD_MEDIUM], tierCount[LOD_LOW],
+                            tierCount[LOD_SILHOUETTE], offscreen, tierChanges),
+                 10, 32, 18, DARKGRAY);
+        DrawText("arrows / WASD move the camera", 10, 54, 18, GRAY);
+        DrawFPS(screenW - 90, 10);
+        EndDrawing();
+    }
+    CloseWindow();
+}
+
+StressStats StressScene::runHeadless(JobSystem &jobs, long frames)
+{
+    StressStats stats;
+    for (long f = 0; f < frames; ++f)
+    {
+        moveCamera(1.0f / 60.0f, true);
+        auto t0 = StressClock::now();
+        selectDetail();
+        double lodMs = msSince(t0);
+
+        auto t1 = StressClock::now();
+        crowd.step(jobs);
+        double simMs = msSince(t1);
+
+        auto t2 = StressClock::now();
+        record(batch);
+        batch.build();
+        batch.clear();
+        double drawMs = msSince(t2);
+        tally(stats, simMs, lodMs, drawMs);
+    }
+    return stats;
+}
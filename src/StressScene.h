@@ -0,0 +1,68 @@
+#pragma once
+#include "raylib.h"
+#include "CrowdScene.h"
+#include "JobSystem.h"
+#include "Lod.h"
+#include "PrimitiveBatch.h"
+#include "Target.h"
+#include <cstdint>
+#include <vector>
+
+struct StressStats
+{
+    long frames = 0;
+    double simMs = 0.0, lodMs = 0.0, drawMs = 0.0; // per frame, averaged
+    double maxFrameMs = 0.0;
+    double tiers[LOD_TIERS] = {}; // walkers per tier, averaged over frames
+    double offscreen = 0.0;       // walkers per frame outside the view
+    double tierChanges = 0.0;     // per frame
+    CrowdStats crowd;
+};
+
+// A CrowdScene spread over a ground plane in front of a perspective
+// camera, for stress-testing the walker pipeline with level of detail.
+//
+// Each walker's 900 x 600 round is placed at a world (x, depth) and drawn
+// scaled by the camera's perspective. Every frame the LodPolicy picks a
+// tier per walker from its height on screen and its depth; walkers out of
+// view drop to LOD_SILHOUETTE and are not drawn.
+class StressScene
+{
+public:
+    StressScene(size_t walkers, uint32_t seed, int screenW, int screenH);
+
+    // opens a window; arrows / WASD move the camera
+    void run(JobSystem &jobs);
+    // the same frames without a window, the camera dollying back and
+    // forth through the crowd; draw time is the batch build only
+    StressStats runHeadless(JobSystem &jobs, long frames);
+
+    size_t size() const { return crowd.size(); }
+
+private:
+    void moveCamera(float dt, bool scripted);
+    void selectDetail();
+    void record(PrimitiveBatch &batch);
+    void tally(StressStats &stats, double simMs, double lodMs, double drawMs) const;
+
+    int screenW, screenH;
+    CrowdScene crowd;
+    LodPolicy policy;
+
+    // world placement of each round, and where it lands on screen this frame
+    std::vector<Vector2> placement; // x, depth
+    std::vector<float> scale;       // local px -> screen px, 0 when out of view
+    std::vector<Vector2> anchor;    // screen point of the round's ground center
+    std::vector<Target> targets;    // this frame's visible targets, for Target::drawAll
+
+    float camX = 0.0f, camZ = 0.0f;
+    float depthRange;
+    double clock = 0.0; // seconds, drives the scripted camera
+
+    // this frame's tally
+    long tierCount[LOD_TIERS] = {};
+    long offscreen = 0;
+    long tierChanges = 0;
+
+    PrimitiveBatch batch;
+};
@@ -1,34 +1,88 @@
 #include "Target.h"
 #include <cmath>
+#include <vector>
 
-Target::Target(Vector2 pos, float radius, Color color)
-	: pos(pos), radius(radius), color(color)
+Target::Target(Vector2 pos, float radius, Color color, TargetShape shape)
+	: pos(pos), radius(radius), color(color), shape(shape)
 {
 }
 
-void Target::draw() const
+static InstanceMesh buildMesh(TargetShape shape)
 {
-	constexpr int points = 5;
-	Vector2 star[points];
-	float angleOff = -PI / 2.0f;
-
-	for (int i = 0; i < points; ++i)
+	InstanceMesh mesh;
+	switch (shape)
+	{
+	case TARGET_STAR:
+	default:
 	{
-		float ang = angleOff + i * 2 * PI / points;
-		star[i] = {
-			pos.x + radius * cosf(ang),
-			pos.y + radius * sinf(ang)};
+		constexpr int points = 5;
+		Vector2 star[points];
+		float angleOff = -PI / 2.0f;
+
+		for (int i = 0; i < points; ++i)
+		{
+			float ang = angleOff + i * 2 * PI / points;
+			star[i] = {cosf(ang), sinf(ang)};
+		}
+
+		const int order[points + 1] = {0, 2, 4, 1, 3, 0};
+		for (int i = 0; i < points; ++i)
+			mesh.addLine(star[order[i]], star[order[i + 1]], 1.0f);
+
+		for (int i = 0; i < points; ++i)
+			mesh.addDot(star[i], 3);
+		break;
 	}
+	}
+	return mesh;
+}
+
+const InstanceMesh &Target::mesh(TargetShape shape)
+{
+	static const std::vector<InstanceMesh> meshes = []
+	{
+		std::vector<InstanceMesh> m;
+		for (int s = 0; s < TARGET_SHAPE_COUNT; ++s)
+			m.push_back(buildMesh(static_cast<TargetShape>(s)));
+		return m;
+	}();
+	return meshes[shape];
+}
 
-	const int order[points + 1] = {0, 2, 4, 1, 3, 0};
-	for (int i = 0; i < points; ++i)
-		DrawLineV(star[order[i]], star[order[i + 1]], color);
+void Target::draw() const
+{
+	PrimitiveBatch batch;
+	draw(batch);
+	batch.flush();
+}
+
+void Target::draw(PrimitiveBatch &batch) const
+{
+	PrimitiveBatch::Instance in = {pos, radius, color};
+	batch.instances(mesh(shape), &in, 1);
+}
 
-	for (int i = 0; i < points; ++i)
-		DrawCircleV(star[i], 3, color);
+void Target::drawAll(const Target *targets, size_t count, PrimitiveBatch &batch)
+{
+	// written straight into the batch's instance buffer, nothing to allocate
+	for (int s = 0; s < TARGET_SHAPE_COUNT; ++s)
+	{
+		size_t n = 0;
+		for (size_t i = 0; i < count; ++i)
+			n += targets[i].shape == s;
+		PrimitiveBatch::Instance *out = batch.instances(mesh(static_cast<TargetShape>(s)), n);
+		for (size_t i = 0; i < count; ++i)
+			if (targets[i].shape == s)
+				*out++ = {targets[i].pos, targets[i].radius, targets[i].color};
+	}
 }
 
 Vector2 Target::getPos() const
 {
 	return pos;
 }
+
+Circle Target::bounds() const
+{
+	return {pos.x, pos.y, radius};
+}
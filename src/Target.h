@@ -1,17 +1,36 @@
 #pragma once
 
 #include "raylib.h"
+#include "PrimitiveBatch.h"
+#include "Shapes.h"
+#include <cstddef>
+
+// New shapes only need a case in Target.cpp's buildMesh()
+enum TargetShape
+{
+    TARGET_STAR,
+    TARGET_SHAPE_COUNT
+};
 
 class Target
 {
 public:
-    Target(Vector2 pos, float radius, Color color);
+    Target(Vector2 pos, float radius, Color color, TargetShape shape = TARGET_STAR);
 
     void draw() const;
+    void draw(PrimitiveBatch &batch) const;
+    // one instance group per shape for the whole array; the batch expands
+	// them into its current run
+    static void drawAll(const Target *targets, size_t count, PrimitiveBatch &batch);
     Vector2 getPos() const;
+    Circle bounds() const;
+
+    // unit-radius geometry, built on first use and shared by every target
+    static const InstanceMesh &mesh(TargetShape shape);
 
     // raw data kept public to preserve existing usage
     Vector2 pos;
     float radius;
     Color color;
+    TargetShape shape;
 };
@@ -0,0 +1,112 @@
+#include "ThrowSolver.h"
+#include <algorithm>
+#include <cmath>
+
+ThrowSolver::ThrowSolver(const ThrowConstraints &constraints, float rangeX, float rangeY, float cellSize)
+    : limits(constraints), rangeX(rangeX), rangeY(rangeY), cellSize(cellSize)
+{
+    // columns cover |dx| in [0, rangeX], rows cover dy in [-rangeY, rangeY]
+    cols = static_cast<int>(std::ceil(rangeX / cellSize)) + 1;
+    rows = static_cast<int>(std::ceil(2 * rangeY / cellSize)) + 1;
+    table.resize(cols * rows);
+    tableFeasible.resize(cols * rows);
+
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c)
+        {
+            bool feasible;
+            table[r * cols + c] = bestTime(c * cellSize, r * cellSize - rangeY, feasible);
+            tableFeasible[r * cols + c] = feasible;
+        }
+}
+
+// y grows downwards, so an upward release has vy < 0
+void ThrowSolver::evaluate(float dx, float dy, float t, float &violation, float &angleError) const
+{
+    float g = limits.gravity;
+    float vx = dx / t;
+    float vy = dy / t - 0.5f * g * t;
+
+    float speed = sqrtf(vx * vx + vy * vy);
+    float rise = vy < 0.0f ? vy * vy / (2 * g) : 0.0f;       // apex height above the hand
+    float clearance = rise - std::max(0.0f, -dy);             // above the higher end point
+    violation = std::max(0.0f, speed - limits.maxSpeed) / limits.maxSpeed +
+                std::max(0.0f, limits.minApexClearance - clearance) / std::max(limits.minApexClearance, 1.0f);
+    angleError = fabsf(atan2f(-vy, fabsf(vx)) - limits.preferredAngle);
+}
+
+float ThrowSolver::bestTime(float dx, float dy, bool &feasible) const
+{
+    const int samples = 192;
+    float best = limits.minTime, bestViolation = INFINITY, bestAngle = INFINITY;
+    auto consider = [&](float t)
+    {
+        float violation, angle;
+        evaluate(dx, dy, t, violation, angle);
+        if (violation < bestViolation - 1e-6f || (violation <= bestViolation + 1e-6f && angle < bestAngle))
+        {
+            best = t;
+            bestViolation = violation;
+            bestAngle = angle;
+        }
+    };
+
+    float step = (limits.maxTime - limits.minTime) / (samples - 1);
+    for (int i = 0; i < samples; ++i)
+        consider(limits.minTime + i * step);
+    // refine around the best sample
+    float lo = std::max(limits.minTime, best - step), hi = std::min(limits.maxTime, best + step);
+    for (int i = 0; i <= 32; ++i)
+        consider(lo + (hi - lo) * i / 32);
+
+    feasible = bestViolation <= 0.0f;
+    return best;
+}
+
+ThrowSolution ThrowSolver::fromTime(float dx, float dy, float t, bool feasible) const
+{
+    return {{dx / t, dy / t - 0.5f * limits.gravity * t}, t, feasible};
+}
+
+ThrowSolution ThrowSolver::solveDirect(Vector2 from, Vector2 to) const
+{
+    float dx = to.x - from.x, dy = to.y - from.y;
+    bool feasible;
+    float t = bestTime(dx, dy, feasible);
+    return fromTime(dx, dy, t, feasible);
+}
+
+ThrowSolution ThrowSolver::solve(Vector2 from, Vector2 to) const
+{
+    float dx = to.x - from.x, dy = to.y - from.y;
+    float fx = fabsf(dx) / cellSize, fy = (dy + rangeY) / cellSize;
+    if (fx >= cols - 1 || fy < 0.0f || fy >= rows - 1)
+        return solveDirect(from, to);
+
+    int c = static_cast<int>(fx), r = static_cast<int>(fy);
+    float ax = fx - c, ay = fy - r;
+    int i00 = r * cols + c, i01 = i00 + 1, i10 = i00 + cols, i11 = i10 + 1;
+    if (!(tableFeasible[i00] & tableFeasible[i01] & tableFeasible[i10] & tableFeasible[i11]))
+        return solveDirect(from, to);
+
+    float t = (table[i00] * (1 - ax) + table[i01] * ax) * (1 - ay) +
+              (table[i10] * (1 - ax) + table[i11] * ax) * ay;
+
+    // the optimum often sits on a constraint edge, where the blend can land
+    // just outside; the corner times are the next cheapest candidates
+    const float candidates[5] = {t, table[i00], table[i01], table[i10], table[i11]};
+    float best = -1.0f, bestAngle = INFINITY;
+    for (float candidate : candidates)
+    {
+        float violation, angle;
+        evaluate(dx, dy, candidate, violation, angle);
+        if (violation <= 0.0f && angle < bestAngle)
+        {
+            best = candidate;
+            bestAngle = angle;
+        }
+    }
+    if (best < 0.0f)
+        return solveDirect(from, to);
+    return fromTime(dx, dy, best, true);
+}
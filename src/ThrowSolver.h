@@ -0,0 +1,51 @@
+#pragma once
+#include "raylib.h"
+#include <vector>
+
+struct ThrowConstraints
+{
+    float gravity = 750.0f;
+    float maxSpeed = 1100.0f;
+    float minApexClearance = 40.0f; // apex must rise this far above the higher end point
+    float preferredAngle = 50.0f * DEG2RAD; // release elevation above horizontal
+    float minTime = 0.15f, maxTime = 2.0f;
+};
+
+struct ThrowSolution
+{
+    Vector2 velocity;
+    float time; // flight time to the target
+    bool feasible; // false: best effort, some constraint is violated
+};
+
+// Picks a release velocity for a hand -> target throw under ThrowConstraints.
+//
+// Any flight time T gives a parabola through the target, so the solver only
+// has to choose T. A table of the best T over (|dx|, dy) is built once;
+// solve() interpolates it and rebuilds the velocity from T, which keeps the
+// throw exactly on target. When the interpolated T breaks a constraint the
+// four corner times are tried; queries outside the table, or where none of
+// them fits, fall back to solveDirect().
+class ThrowSolver
+{
+public:
+    explicit ThrowSolver(const ThrowConstraints &constraints = ThrowConstraints(),
+                         float rangeX = 1000.0f, float rangeY = 600.0f, float cellSize = 20.0f);
+
+    ThrowSolution solve(Vector2 from, Vector2 to) const;
+    ThrowSolution solveDirect(Vector2 from, Vector2 to) const;
+
+    const ThrowConstraints &constraints() const { return limits; }
+
+private:
+    // violation measure (0 when feasible) and angle error for flight time t
+    void evaluate(float dx, float dy, float t, float &violation, float &angleError) const;
+    float bestTime(float dx, float dy, bool &feasible) const;
+    ThrowSolution fromTime(float dx, float dy, float t, bool feasible) const;
+
+    ThrowConstraints limits;
+    float rangeX, rangeY, cellSize;
+    int cols, rows;
+    std::vector<float> table; // best T per (|dx|, dy) node
+    std::vector<unsigned char> tableFeasible;
+};
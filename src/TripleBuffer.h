@@ -0,0 +1,45 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-writer, single-reader handoff of the latest T.
+//
+// The writer fills back(), then publish() swaps it with the shared middle
+// slot; the reader's acquire() swaps the middle slot with its front slot
+// when something new was published. Neither side ever waits, the reader
+// always sees a complete T, and a T the reader never picked up is simply
+// overwritten by the next publish().
+template <class T>
+class TripleBuffer
+{
+public:
+    // writer side
+    T &back() { return slots[backIndex]; }
+    // returns true if the previous publish was never read (a dropped T)
+    bool publish()
+    {
+        uint8_t prev = middle.exchange(static_cast<uint8_t>(backIndex | kFresh), std::memory_order_acq_rel);
+        backIndex = prev & kIndexMask;
+        return (prev & kFresh) != 0;
+    }
+
+    // reader side: returns true if front() changed
+    bool acquire()
+    {
+        if (!(middle.load(std::memory_order_relaxed) & kFresh))
+            return false;
+        uint8_t prev = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = prev & kIndexMask;
+        return true;
+    }
+    const T &front() const { return slots[frontIndex]; }
+
+private:
+    static constexpr uint8_t kIndexMask = 3;
+    static constexpr uint8_t kFresh = 4;
+
+    T slots[3];
+    uint8_t backIndex = 0;  // writer only
+    uint8_t frontIndex = 2; // reader only
+    std::atomic<uint8_t> middle{1};
+};
@@ -0,0 +1,35 @@
+#include "WalkCycle.h"
+#include <cmath>
+
+void WalkCycle::sample(float t, Vector2 anchor, WalkerPose &pose) const
+{
+    float u = t * (kSamples / (2 * PI));
+    float fl = floorf(u);
+    int i = static_cast<int>(fl) % kSamples;
+    if (i < 0)
+        i += kSamples;
+    float alpha = u - fl;
+
+    pose = lerpPose(keys[i], keys[i + 1], alpha);
+    translatePose(pose, anchor);
+}
+
+void translatePose(WalkerPose &pose, Vector2 offset)
+{
+    auto move = [offset](Vector2 &p)
+    { p.x += offset.x, p.y += offset.y; };
+    move(pose.torsoBottom);
+    move(pose.torsoTop);
+    move(pose.headCenter);
+    for (Limb2 *l : {&pose.leftLeg, &pose.rightLeg, &pose.leftArm, &pose.rightArm})
+    {
+        move(l->root);
+        move(l->joint);
+        move(l->tip);
+    }
+    for (Finger2 &f : pose.fingers)
+    {
+        move(f.root);
+        move(f.tip);
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "raylib.h"
+#include "Walker.h"
+#include <vector>
+
+// One gait period of a walker sampled into keyframes.
+//
+// While a walker is just walking its pose depends only on the phase t and
+// its x position, so the cycle is baked once with the hip anchor at the
+// origin and sampled at runtime by lerping the two nearest keys and moving
+// them to the walker's anchor, so a walking walker runs no trig at all.
+class WalkCycle
+{
+public:
+    static constexpr int kSamples = 96; // per 2 pi of phase
+
+    // bakeKey(phase, pose) fills in the live pose at that phase, anchored
+    // at the origin
+    template <class BakeKey>
+    void bake(BakeKey &&bakeKey)
+    {
+        keys.resize(kSamples + 1);
+        for (int i = 0; i < kSamples; ++i)
+            bakeKey(i * (2 * PI / kSamples), keys[i]);
+        keys[kSamples] = keys[0];
+    }
+
+    bool baked() const { return !keys.empty(); }
+
+    // pose at phase t (any value, wrapped to one period) moved to anchor
+    void sample(float t, Vector2 anchor, WalkerPose &pose) const;
+
+private:
+    std::vector<WalkerPose> keys; // keys[kSamples] repeats keys[0]
+};
+
+// Adds offset to every point of the pose.
+void translatePose(WalkerPose &pose, Vector2 offset);
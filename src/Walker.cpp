@@ -1,51 +1,246 @@
 #include "Walker.h"
+#include "IK.h"
+#include "Profiler.h"
+#include "FastTrig.h"
+#include "WalkCycle.h"
 #include <algorithm>
 #include <cmath>
 
+// joint limits in degrees, wide enough for the walk, squat and throw
+static constexpr float kKneeMin = -5.0f, kKneeMax = 180.0f;
+static constexpr float kElbowMin = -150.0f, kElbowMax = 30.0f;
+
 Walker::Walker(Vector2 ballC, float ballR)
     : ballCenter(ballC), ballRadius(ballR) {}
 
-void Walker::init()
+void Walker::init(float startX, float tickDt)
 {
     t = 0.0f;
+    phaseStep = 0;
     reached = false;
+    poseValid = false;
 
     baseY = 500.0f;
     float legLength = 46.0f + 44.0f;
-    position = {100, baseY - legLength + 18.0f};
+    position = {startX, baseY - legLength + 18.0f};
 
-    speed = 2.0f;
     stride = 22.0f;
     lift = 8.0f;
     torsoLen = 80.0f;
     headRadius = 18.0f;
-    stepPeriod = 48.0f;
+    setTickDt(tickDt);
+
+    buildSkeleton();
+    // posed from the start: coarse tiers may not advance for a few ticks
+    updateTorso();
+    updateLegs();
+    updateArms();
+    updateFingers();
+    skeletonStale = true;
+}
+
+float Walker::speedPerTick(float tickDt)
+{
+    return static_cast<float>(kWalkSpeed * tickDt);
+}
+
+int Walker::stepsPerCycle(float tickDt)
+{
+    return std::max(1, static_cast<int>(std::lround(kStepPeriod / tickDt)));
+}
 
-    fingers.resize(3);
+// The phase still moves in whole steps, now as many per cycle as there are
+// ticks in kStepPeriod; a walk under way keeps its place in the cycle.
+void Walker::setTickDt(float tickDt)
+{
+    speed = speedPerTick(tickDt);
+    int steps = stepsPerCycle(tickDt);
+    phaseStep = static_cast<int>(static_cast<long>(phaseStep) * steps / static_cast<int>(stepPeriod));
+    stepPeriod = static_cast<float>(steps);
+    t = phaseStep * (2 * PI / stepPeriod);
 }
 
 void Walker::step()
 {
-    if (!reached && position.x < ballCenter.x - 65)
+    advance(1, LOD_FULL);
+}
+
+// `ticks` steps of walking, then a single pose update; below LOD_FULL the
+// fingers are left where they were
+void Walker::advance(int ticks, LodTier tier)
+{
+    PROFILE_ZONE("Walker::step");
+    for (int k = 0; k < ticks; ++k)
+    {
+        if (!reached && position.x < ballCenter.x - 65)
+        {
+            position.x += speed;
+            // whole steps, so the phase never drifts away from the baked keys
+            phaseStep = (phaseStep + 1) % static_cast<int>(stepPeriod);
+            t = phaseStep * (2 * PI / stepPeriod);
+        }
+        else
+        {
+            reached = true;
+        }
+    }
+
+    // standing at the ball with nothing going on, the pose is the same
+    // every tick
+    PoseInputs in = poseInputs(tier);
+    if (usePoseCache && poseCurrent(in))
+    {
+        ++posesSkipped;
+        return;
+    }
+    lastPose = in;
+    poseValid = true;
+    ++posesComputed;
+    skeletonStale = true;
+
+    if (!reached && useWalkCycle && throwWindupPhase == 0.0f && throwFwdPhase == 0.0f)
     {
-        position.x += speed;
-        t += 2 * PI / stepPeriod;
+        float hipY = baseY - (46.0f + 44.0f) + 18.0f;
+        WalkerPose pose;
+        walkCycle().sample(t, {position.x, hipY}, pose);
+        applyPose(pose);
     }
     else
     {
-        reached = true;
+        updateTorso();
+        updateLegs();
+        updateArms();
+        if (tier == LOD_FULL)
+            updateFingers();
     }
+}
 
-    updateTorso();
-    updateLegs();
-    updateArms();
-    updateFingers();
+Walker::PoseInputs Walker::poseInputs(LodTier tier) const
+{
+    return {t, position.x, throwWindupPhase, throwFwdPhase, ballCenter, reached, standUp, useWalkCycle, tier};
+}
+
+bool Walker::poseCurrent(const PoseInputs &in) const
+{
+    const PoseInputs &p = lastPose;
+    return poseValid && p.tier <= in.tier && p.t == in.t && p.x == in.x && p.windup == in.windup
+           && p.throwFwd == in.throwFwd && p.ball.x == in.ball.x && p.ball.y == in.ball.y
+           && p.reached == in.reached && p.standUp == in.standUp && p.walkCycle == in.walkCycle;
+}
+
+const WalkCycle &Walker::walkCycle()
+{
+    static const WalkCycle cycle = []
+    {
+        // a walker that never reaches its ball, posed at each phase with
+        // its hip anchor (x position, rest hip height) at the origin
+        Walker w({INFINITY, 0.0f}, 1.0f);
+        w.init();
+        w.useWalkCycle = false;
+        float hipY = w.baseY - (46.0f + 44.0f) + 18.0f;
+
+        WalkCycle c;
+        c.bake([&](float phase, WalkerPose &pose)
+               {
+                   w.t = phase;
+                   w.position.x = 0.0f;
+                   w.updateTorso();
+                   w.updateLegs();
+                   w.updateArms();
+                   w.updateFingers();
+                   pose = w.getPose();
+                   translatePose(pose, {0.0f, -hipY}); });
+        return c;
+    }();
+    return cycle;
+}
+
+void Walker::applyPose(const WalkerPose &pose)
+{
+    torsoBottom = pose.torsoBottom;
+    torsoTop = pose.torsoTop;
+    headCenter = pose.headCenter;
+    leftLeg = pose.leftLeg;
+    rightLeg = pose.rightLeg;
+    leftArm = pose.leftArm;
+    rightArm = pose.rightArm;
+    for (int i = 0; i < 3; ++i)
+        fingers[i] = pose.fingers[i];
+}
+
+void Walker::buildSkeleton()
+{
+    static_assert(BONE_COUNT <= Skeleton::kInlineSegments, "a walker's bones must fit inline");
+    segments.clear();
+    segments.add(torsoLen, -180.0f, 180.0f);
+    for (int side = 0; side < 2; ++side)
+    {
+        int thigh = segments.add(46.0f, -180.0f, 180.0f);
+        segments.add(44.0f, kKneeMin, kKneeMax, thigh);
+    }
+    for (int side = 0; side < 2; ++side)
+    {
+        int upper = segments.add(38.0f, -180.0f, 180.0f);
+        segments.add(34.0f, kElbowMin, kElbowMax, upper);
+    }
+    for (int i = 0; i < 3; ++i)
+        segments.add(10.0f, -30.0f, 30.0f, BONE_RIGHT_FOREARM);
+}
+
+const Skeleton &Walker::getSkeleton()
+{
+    if (skeletonStale)
+    {
+        updateSkeleton();
+        skeletonStale = false;
+    }
+    return segments;
+}
+
+// Mirrors the solved limbs into the skeleton as joint angles. The IK
+// stretches a leg when its foot is out of reach, so bone lengths are
+// taken from the solved limb too, not the rest lengths buildSkeleton() set.
+void Walker::updateSkeleton()
+{
+    auto degrees = [](Vector2 from, Vector2 to)
+    { return RAD2DEG * trig::atan2(to.y - from.y, to.x - from.x); };
+    auto length = [](Vector2 from, Vector2 to)
+    { return sqrtf((to.x - from.x) * (to.x - from.x) + (to.y - from.y) * (to.y - from.y)); };
+    auto relative = [](float child, float parent)
+    {
+        float d = child - parent;
+        return d - 360.0f * floorf((d + 180.0f) * (1.0f / 360.0f));
+    };
+    auto setLimb = [&](int upper, const Limb2 &limb)
+    {
+        float a1 = degrees(limb.root, limb.joint), a2 = degrees(limb.joint, limb.tip);
+        segments.setRoot(upper, limb.root);
+        segments.setAngle(upper, a1);
+        segments.setAngle(upper + 1, relative(a2, a1));
+        segments.setLength(upper, length(limb.root, limb.joint));
+        segments.setLength(upper + 1, length(limb.joint, limb.tip));
+    };
+
+    segments.setRoot(BONE_TORSO, torsoBottom);
+    segments.setAngle(BONE_TORSO, degrees(torsoBottom, torsoTop));
+    segments.setLength(BONE_TORSO, length(torsoBottom, torsoTop));
+    setLimb(BONE_LEFT_THIGH, leftLeg);
+    setLimb(BONE_RIGHT_THIGH, rightLeg);
+    setLimb(BONE_LEFT_UPPER_ARM, leftArm);
+    setLimb(BONE_RIGHT_UPPER_ARM, rightArm);
+    float forearm = degrees(rightArm.joint, rightArm.tip);
+    for (int i = 0; i < 3; ++i)
+    {
+        segments.setAngle(BONE_FINGER + i, relative(degrees(fingers[i].root, fingers[i].tip), forearm));
+        segments.setLength(BONE_FINGER + i, length(fingers[i].root, fingers[i].tip));
+    }
+    segments.solve();
 }
 
 void Walker::updateTorso()
 {
-    float bob = 3.0f * sinf(2 * t);
-    float sway = 3.0f * sinf(t);
+    float bob = 3.0f * trig::sin(2 * t);
+    float sway = 3.0f * trig::sin(t);
 
     float legLength = 46.0f + 44.0f;
     float hipY = baseY - legLength + 18.0f - bob;
@@ -81,15 +276,15 @@ void Walker::updateTorso()
                 if (dist > maxReach)
                 {
                     Vector2 toBall = {ballCenter.x - torsoBottom.x, ballCenter.y - torsoBottom.y};
-                    torsoAngle = std::clamp(atan2f(toBall.x, toBall.y), -0.7f, 0.7f);
+                    torsoAngle = std::clamp(trig::atan2(toBall.x, toBall.y), -0.7f, 0.7f);
                 }
             }
         }
     }
 
     torsoTop = {
-        torsoBottom.x + torsoLen * sinf(torsoAngle),
-        torsoBottom.y - torsoLen * cosf(torsoAngle)};
+        torsoBottom.x + torsoLen * trig::sin(torsoAngle),
+        torsoBottom.y - torsoLen * trig::cos(torsoAngle)};
     headCenter = {torsoTop.x, torsoTop.y - headRadius - 4};
 }
 
@@ -114,14 +309,14 @@ void Walker::updateLegs()
         {
             float swingNorm = normPhase / swingStart;
             stepX = (isLeft ? -13.0f : 13.0f) + stride * (2 * swingNorm - 1);
-            stepY = baseY - lift * sinf(PI * swingNorm);
+            stepY = baseY - lift * trig::sin(PI * swingNorm);
             kneeBend = 0.9f * (1 - swingNorm);
         }
         else
         {
             stepX = (isLeft ? -13.0f : 13.0f);
             stepY = baseY;
-            kneeBend = 0.2f * (1 - cosf(PI * (normPhase - swingStart) / (2 * PI * stanceDuration)));
+            kneeBend = 0.2f * (1 - trig::cos(PI * (normPhase - swingStart) / (2 * PI * stanceDuration)));
         }
         Vector2 foot = {position.x + stepX, stepY};
         return {foot, kneeBend};
@@ -135,25 +330,13 @@ void Walker::updateLegs()
 
     auto solve_leg = [](Vector2 hip, Vector2 foot, float upper, float lower, float kneeBlend, Limb2 &limb)
     {
-        Vector2 d = {foot.x - hip.x, foot.y - hip.y};
-        float len = sqrtf(d.x * d.x + d.y * d.y);
-        len = fminf(len, upper + lower - 1.0f);
-
-        float a_straight = 0.0f;
-        float a_bent = acosf(fmaxf(-1.0f, fminf(1.0f, (upper * upper + len * len - lower * lower) / (2 * upper * len))));
-        float a = kneeBlend * a_bent + (1 - kneeBlend) * a_straight;
-
-        float b = atan2f(d.x, d.y);
-        float theta1 = b + fabsf(a);
-        float theta2 = PI - acosf(fmaxf(-1.0f, fminf(1.0f, (upper * upper + lower * lower - len * len) / (2 * upper * lower))));
+        TwoBoneResult ik = solveTwoBone(hip, foot, upper, lower, kneeBlend);
         limb.root = hip;
         limb.len1 = upper;
         limb.len2 = lower;
-        limb.theta1 = theta1;
-        limb.theta2 = theta2;
-        limb.joint = {
-            hip.x + upper * sinf(theta1),
-            hip.y + upper * cosf(theta1)};
+        limb.theta1 = ik.theta1;
+        limb.theta2 = ik.theta2;
+        limb.joint = ik.joint;
         limb.tip = foot;
     };
 
@@ -186,13 +369,13 @@ void Walker::updateArms()
         rightArm.len1 = upper;
         rightArm.len2 = lower;
         rightArm.theta1 = swing;
-        rightArm.theta2 = 0.15f * (throwFwdPhase > 0.0f ? -sinf(PI * throwFwdPhase) : sinf(throwWindupPhase));
+        rightArm.theta2 = 0.15f * (throwFwdPhase > 0.0f ? -trig::sin(PI * throwFwdPhase) : trig::sin(throwWindupPhase));
         rightArm.joint = {
-            rightArm.root.x + upper * sinf(rightArm.theta1),
-            rightArm.root.y + upper * cosf(rightArm.theta1)};
+            rightArm.root.x + upper * trig::sin(rightArm.theta1),
+            rightArm.root.y + upper * trig::cos(rightArm.theta1)};
         rightArm.tip = {
-            rightArm.joint.x + lower * sinf(rightArm.theta1 + rightArm.theta2),
-            rightArm.joint.y + lower * cosf(rightArm.theta1 + rightArm.theta2)};
+            rightArm.joint.x + lower * trig::sin(rightArm.theta1 + rightArm.theta2),
+            rightArm.joint.y + lower * trig::cos(rightArm.theta1 + rightArm.theta2)};
 
         // Left arm just idle during throw
         leftArm.root = shoulderL;
@@ -201,61 +384,50 @@ void Walker::updateArms()
         leftArm.theta1 = -1.2f;
         leftArm.theta2 = 0.0f;
         leftArm.joint = {
-            leftArm.root.x + upper * sinf(leftArm.theta1),
-            leftArm.root.y + upper * cosf(leftArm.theta1)};
+            leftArm.root.x + upper * trig::sin(leftArm.theta1),
+            leftArm.root.y + upper * trig::cos(leftArm.theta1)};
         leftArm.tip = {
-            leftArm.joint.x + lower * sinf(leftArm.theta1 + leftArm.theta2),
-            leftArm.joint.y + lower * cosf(leftArm.theta1 + leftArm.theta2)};
+            leftArm.joint.x + lower * trig::sin(leftArm.theta1 + leftArm.theta2),
+            leftArm.joint.y + lower * trig::cos(leftArm.theta1 + leftArm.theta2)};
 
         return;
     }
 
     // --- DEFAULT (walking/idle/grab) ---
-    float swingL = 0.8f * sinf(t + PI);
-    float swingR = 0.8f * sinf(t);
+    float swingL = 0.8f * trig::sin(t + PI);
+    float swingR = 0.8f * trig::sin(t);
 
     leftArm.root = shoulderL;
     leftArm.len1 = upper;
     leftArm.len2 = lower;
     leftArm.theta1 = -1.2f + swingL;
-    leftArm.theta2 = 0.4f * sinf(t + 0.5f);
+    leftArm.theta2 = 0.4f * trig::sin(t + 0.5f);
     leftArm.joint = {
-        leftArm.root.x + upper * sinf(leftArm.theta1),
-        leftArm.root.y + upper * cosf(leftArm.theta1)};
+        leftArm.root.x + upper * trig::sin(leftArm.theta1),
+        leftArm.root.y + upper * trig::cos(leftArm.theta1)};
     leftArm.tip = {
-        leftArm.joint.x + lower * sinf(leftArm.theta1 + leftArm.theta2),
-        leftArm.joint.y + lower * cosf(leftArm.theta1 + leftArm.theta2)};
+        leftArm.joint.x + lower * trig::sin(leftArm.theta1 + leftArm.theta2),
+        leftArm.joint.y + lower * trig::cos(leftArm.theta1 + leftArm.theta2)};
 
     rightArm.root = shoulderR;
     rightArm.len1 = upper;
     rightArm.len2 = lower;
     rightArm.theta1 = 1.2f + swingR;
-    rightArm.theta2 = 0.4f * sinf(t + PI + 0.5f);
+    rightArm.theta2 = 0.4f * trig::sin(t + PI + 0.5f);
     rightArm.joint = {
-        rightArm.root.x + upper * sinf(rightArm.theta1),
-        rightArm.root.y + upper * cosf(rightArm.theta1)};
+        rightArm.root.x + upper * trig::sin(rightArm.theta1),
+        rightArm.root.y + upper * trig::cos(rightArm.theta1)};
     rightArm.tip = {
-        rightArm.joint.x + lower * sinf(rightArm.theta1 + rightArm.theta2),
-        rightArm.joint.y + lower * cosf(rightArm.theta1 + rightArm.theta2)};
+        rightArm.joint.x + lower * trig::sin(rightArm.theta1 + rightArm.theta2),
+        rightArm.joint.y + lower * trig::cos(rightArm.theta1 + rightArm.theta2)};
 
     if (reached)
     {
-        Vector2 target = ballCenter;
-        float l1 = upper, l2 = lower;
-        Vector2 d = {target.x - rightArm.root.x, target.y - rightArm.root.y};
-        float len = sqrtf(d.x * d.x + d.y * d.y);
-        len = fminf(len, l1 + l2 - 1.0f);
-
-        float a = acosf(fmaxf(-1.0f, fminf(1.0f, (l1 * l1 + len * len - l2 * l2) / (2 * l1 * len))));
-        float b = atan2f(d.x, d.y);
-        rightArm.theta1 = b - a;
-        rightArm.theta2 = PI - acosf(fmaxf(-1.0f, fminf(1.0f, (l1 * l1 + l2 * l2 - len * len) / (2 * l1 * l2))));
-        rightArm.joint = {
-            rightArm.root.x + l1 * sinf(rightArm.theta1),
-            rightArm.root.y + l1 * cosf(rightArm.theta1)};
-        rightArm.tip = {
-            rightArm.joint.x + l2 * sinf(rightArm.theta1 + rightArm.theta2),
-            rightArm.joint.y + l2 * cosf(rightArm.theta1 + rightArm.theta2)};
+        TwoBoneResult ik = solveTwoBone(rightArm.root, ballCenter, upper, lower, -1.0f);
+        rightArm.theta1 = ik.theta1;
+        rightArm.theta2 = ik.theta2;
+        rightArm.joint = ik.joint;
+        rightArm.tip = ik.tip;
     }
 }
 
@@ -268,11 +440,18 @@ void Walker::updateFingers()
         float spread = reached ? 0.5f : 0.28f;
         fingers[i].angle = rightArm.theta1 + rightArm.theta2 + (i - 1) * spread;
         fingers[i].tip = {
-            fingers[i].root.x + fingers[i].len * sinf(fingers[i].angle),
-            fingers[i].root.y + fingers[i].len * cosf(fingers[i].angle)};
+            fingers[i].root.x + fingers[i].len * trig::sin(fingers[i].angle),
+            fingers[i].root.y + fingers[i].len * trig::cos(fingers[i].angle)};
     }
 }
 
+bool Walker::handTouchingBall() const
+{
+    float dx = rightArm.tip.x - ballCenter.x, dy = rightArm.tip.y - ballCenter.y;
+    float reach = ballRadius + 10.0f; // finger length
+    return dx * dx + dy * dy <= reach * reach;
+}
+
 bool Walker::fingersTouchingBall() const
 {
     int count = 0;
@@ -283,36 +462,80 @@ bool Walker::fingersTouchingBall() const
 }
 
 void Walker::draw()
+{
+    PrimitiveBatch batch;
+    draw(getPose(), batch);
+    batch.flush();
+    drawLabels();
+}
+
+void Walker::draw(const WalkerPose &pose, PrimitiveBatch &batch)
 {
     // Draw legs
-    DrawLineV(leftLeg.root, leftLeg.joint, DARKBLUE);
-    DrawLineV(leftLeg.joint, leftLeg.tip, DARKBLUE);
-    DrawCircleV(leftLeg.tip, 3, RED);
-    DrawLineV(rightLeg.root, rightLeg.joint, DARKBLUE);
-    DrawLineV(rightLeg.joint, rightLeg.tip, DARKBLUE);
-    DrawCircleV(rightLeg.tip, 3, RED);
+    batch.line(pose.leftLeg.root, pose.leftLeg.joint, DARKBLUE);
+    batch.line(pose.leftLeg.joint, pose.leftLeg.tip, DARKBLUE);
+    batch.circle(pose.leftLeg.tip, 3, RED);
+    batch.line(pose.rightLeg.root, pose.rightLeg.joint, DARKBLUE);
+    batch.line(pose.rightLeg.joint, pose.rightLeg.tip, DARKBLUE);
+    batch.circle(pose.rightLeg.tip, 3, RED);
 
     // Draw torso
-    DrawLineV(torsoBottom, torsoTop, BLACK);
+    batch.line(pose.torsoBottom, pose.torsoTop, BLACK);
 
     // Draw arms
-    DrawLineV(leftArm.root, leftArm.joint, DARKBLUE);
-    DrawLineV(leftArm.joint, leftArm.tip, DARKBLUE);
-    DrawCircleV(leftArm.tip, 3, RED);
-    DrawLineV(rightArm.root, rightArm.joint, DARKBLUE);
-    DrawLineV(rightArm.joint, rightArm.tip, DARKBLUE);
-    DrawCircleV(rightArm.tip, 3, RED);
+    batch.line(pose.leftArm.root, pose.leftArm.joint, DARKBLUE);
+    batch.line(pose.leftArm.joint, pose.leftArm.tip, DARKBLUE);
+    batch.circle(pose.leftArm.tip, 3, RED);
+    batch.line(pose.rightArm.root, pose.rightArm.joint, DARKBLUE);
+    batch.line(pose.rightArm.joint, pose.rightArm.tip, DARKBLUE);
+    batch.circle(pose.rightArm.tip, 3, RED);
 
     // Draw head
-    DrawCircleV(headCenter, headRadius, LIGHTGRAY);
-    DrawCircleLines((int)headCenter.x, (int)headCenter.y, (int)headRadius, BLACK);
+    batch.circle(pose.headCenter, pose.headRadius, LIGHTGRAY);
+    batch.circleLines(pose.headCenter, pose.headRadius, BLACK);
 
     // Draw fingers
-    for (auto &f : fingers)
-        DrawLineV(f.root, f.tip, MAROON), DrawCircleV(f.tip, 2, RED);
+    for (auto &f : pose.fingers)
+        batch.line(f.root, f.tip, MAROON), batch.circle(f.tip, 2, RED);
+}
+
+void Walker::draw(const WalkerPose &pose, PrimitiveBatch &batch, LodTier tier)
+{
+    if (tier == LOD_FULL)
+    {
+        draw(pose, batch);
+        return;
+    }
+
+    if (tier == LOD_SILHOUETTE)
+    {
+        // one stroke per limb, the head as a stub above the torso
+        for (const Limb2 *l : {&pose.leftLeg, &pose.rightLeg, &pose.leftArm, &pose.rightArm})
+            batch.line(l->root, l->tip, DARKGRAY);
+        batch.line(pose.torsoBottom, {pose.headCenter.x, pose.headCenter.y - pose.headRadius}, DARKGRAY);
+        return;
+    }
+
+    for (const Limb2 *l : {&pose.leftLeg, &pose.rightLeg, &pose.leftArm, &pose.rightArm})
+    {
+        batch.line(l->root, l->joint, DARKBLUE);
+        batch.line(l->joint, l->tip, DARKBLUE);
+    }
+    batch.line(pose.torsoBottom, pose.torsoTop, BLACK);
+    batch.circle(pose.headCenter, pose.headRadius, LIGHTGRAY);
+    if (tier == LOD_MEDIUM)
+        batch.circleLines(pose.headCenter, pose.headRadius, BLACK);
+}
 
+void Walker::drawLabels() const
+{
     if (fingersTouchingBall())
-        DrawText("TOUCH!", (int)ballCenter.x + 25, (int)ballCenter.y - 30, 20, GREEN);
+        drawTouchLabel(ballCenter);
+}
+
+void Walker::drawTouchLabel(Vector2 ballCenter)
+{
+    DrawText("TOUCH!", (int)ballCenter.x + 25, (int)ballCenter.y - 30, 20, GREEN);
 }
 
 void Walker::setStandUp(bool value)
@@ -325,8 +548,100 @@ Vector2 Walker::getHandPos() const
     return rightArm.tip;
 }
 
+WalkerPose Walker::getPose() const
+{
+    WalkerPose p;
+    p.torsoBottom = torsoBottom;
+    p.torsoTop = torsoTop;
+    p.headCenter = headCenter;
+    p.headRadius = headRadius;
+    p.leftLeg = leftLeg;
+    p.rightLeg = rightLeg;
+    p.leftArm = leftArm;
+    p.rightArm = rightArm;
+    for (int i = 0; i < 3; ++i)
+        p.fingers[i] = fingers[i];
+    return p;
+}
+
 void Walker::setThrowAnim(float windup, float throwFwd)
 {
     throwWindupPhase = windup;
     throwFwdPhase = throwFwd;
-}
\ No newline at end of file
+}
+WalkerPose lerpPose(const WalkerPose &a, const WalkerPose &b, float alpha)
+{
+    auto mix = [alpha](float x, float y)
+    { return x + (y - x) * alpha; };
+    auto mixV = [&mix](Vector2 p, Vector2 q) -> Vector2
+    { return {mix(p.x, q.x), mix(p.y, q.y)}; };
+    auto mixLimb = [&](const Limb2 &p, const Limb2 &q)
+    {
+        Limb2 l = q;
+        l.root = mixV(p.root, q.root);
+        l.joint = mixV(p.joint, q.joint);
+        l.tip = mixV(p.tip, q.tip);
+        l.theta1 = mix(p.theta1, q.theta1);
+        l.theta2 = mix(p.theta2, q.theta2);
+        return l;
+    };
+
+    WalkerPose out = b;
+    out.torsoBottom = mixV(a.torsoBottom, b.torsoBottom);
+    out.torsoTop = mixV(a.torsoTop, b.torsoTop);
+    out.headCenter = mixV(a.headCenter, b.headCenter);
+    out.leftLeg = mixLimb(a.leftLeg, b.leftLeg);
+    out.rightLeg = mixLimb(a.rightLeg, b.rightLeg);
+    out.leftArm = mixLimb(a.leftArm, b.leftArm);
+    out.rightArm = mixLimb(a.rightArm, b.rightArm);
+    for (int i = 0; i < 3; ++i)
+    {
+        out.fingers[i].root = mixV(a.fingers[i].root, b.fingers[i].root);
+        out.fingers[i].tip = mixV(a.fingers[i].tip, b.fingers[i].tip);
+        out.fingers[i].angle = mix(a.fingers[i].angle, b.fingers[i].angle);
+    }
+    return out;
+}
+
+void transformPose(WalkerPose &pose, Vector2 origin, float scale, Vector2 offset)
+{
+    auto map = [&](Vector2 &p)
+    { p = {(p.x - origin.x) * scale + offset.x, (p.y - origin.y) * scale + offset.y}; };
+    map(pose.torsoBottom);
+    map(pose.torsoTop);
+    map(pose.headCenter);
+    pose.headRadius *= scale;
+    for (Limb2 *l : {&pose.leftLeg, &pose.rightLeg, &pose.leftArm, &pose.rightArm})
+    {
+        map(l->root);
+        map(l->joint);
+        map(l->tip);
+        l->len1 *= scale;
+        l->len2 *= scale;
+    }
+    for (Finger2 &f : pose.fingers)
+    {
+        map(f.root);
+        map(f.tip);
+        f.len *= scale;
+    }
+}
+
+void poseExtentX(const WalkerPose &pose, float &minX, float &maxX)
+{
+    minX = pose.headCenter.x - pose.headRadius;
+    maxX = pose.headCenter.x + pose.headRadius;
+    auto grow = [&](Vector2 p)
+    {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+    };
+    grow(pose.torsoBottom);
+    for (const Limb2 *l : {&pose.leftLeg, &pose.rightLeg, &pose.leftArm, &pose.rightArm})
+    {
+        grow(l->joint);
+        grow(l->tip);
+    }
+    for (const Finger2 &f : pose.fingers)
+        grow(f.tip);
+}
@@ -1,7 +1,9 @@
 #pragma once
 #include "raylib.h"
 #include "OOCatcher.h"
-#include <vector>
+#include "Lod.h"
+#include "PrimitiveBatch.h"
+#include <array>
 
 struct Limb2
 {
@@ -18,34 +20,131 @@ struct Finger2
     Vector2 tip;
 };
 
-class Walker : public OOCatcher
+// snapshot of everything Walker::draw needs
+struct WalkerPose
+{
+    Vector2 torsoBottom, torsoTop, headCenter;
+    float headRadius;
+    Limb2 leftLeg, rightLeg, leftArm, rightArm;
+    Finger2 fingers[3];
+};
+
+class WalkCycle;
+
+// linear blend between two poses, used to draw between simulation ticks
+WalkerPose lerpPose(const WalkerPose &a, const WalkerPose &b, float alpha);
+// (p - origin) * scale + offset for every point, lengths and radii scaled
+void transformPose(WalkerPose &pose, Vector2 origin, float scale, Vector2 offset);
+// horizontal extent of every point of the pose, head included
+void poseExtentX(const WalkerPose &pose, float &minX, float &maxX);
+
+class Walker : public OOCatcher<Walker>
 {
 public:
     Walker(Vector2 ballCenter, float ballRadius);
-    void init() override;
-    void step() override;
-    void draw() override;
+    // starts the walk at x = startX, left of its ball, stepped every
+    // tickDt seconds
+    void init(float startX = 100.0f, float tickDt = 1.0f / 60.0f);
+    // walking speed and gait period stay the same in seconds for any tick
+    void setTickDt(float tickDt);
+    // the gait in seconds, shared with WalkerPool
+    static constexpr double kWalkSpeed = 120.0; // px/s
+    static constexpr double kStepPeriod = 0.8;  // s per gait cycle
+    // px walked per tick, and whole ticks per gait cycle
+    static float speedPerTick(float tickDt);
+    static int stepsPerCycle(float tickDt);
+    void step();
+    // `ticks` steps at once with the detail of `tier` (see Lod.h)
+    void advance(int ticks, LodTier tier);
+    void draw();
+    void draw(PrimitiveBatch &batch) const { draw(getPose(), batch); }
+    static void draw(const WalkerPose &pose, PrimitiveBatch &batch);
+    static void draw(const WalkerPose &pose, PrimitiveBatch &batch, LodTier tier);
+    void drawLabels() const;
+    static void drawTouchLabel(Vector2 ballCenter);
+    Vector2 getBallCenter() const { return ballCenter; }
     void setStandUp(bool value);
     bool fingersTouchingBall() const;
+    // hand within a finger's length of the ball; the grab test below LOD_FULL
+    bool handTouchingBall() const;
     Vector2 getHandPos() const;
+    WalkerPose getPose() const;
+    // segment indices in getSkeleton()
+    enum Bone
+    {
+        BONE_TORSO,
+        BONE_LEFT_THIGH,
+        BONE_LEFT_SHIN,
+        BONE_RIGHT_THIGH,
+        BONE_RIGHT_SHIN,
+        BONE_LEFT_UPPER_ARM,
+        BONE_LEFT_FOREARM,
+        BONE_RIGHT_UPPER_ARM,
+        BONE_RIGHT_FOREARM,
+        BONE_FINGER,
+        BONE_COUNT = BONE_FINGER + 3
+    };
+    // the limbs as joint angles and lengths, posed on the first call after
+    // they moved; every bone ends where getPose() puts its joint
+    const Skeleton &getSkeleton();
     void setThrowAnim(float windup, float throwFwd);
+    // plain walking reads the baked cycle instead of running IK (default on)
+    void setWalkCycleCache(bool enabled) { useWalkCycle = enabled; }
+    // skip the pose update while its inputs are unchanged (default on);
+    // benchmarks of the update itself turn it off
+    void setPoseCache(bool enabled) { usePoseCache = enabled; }
+    // pose updates advance() ran, and skipped because nothing the pose
+    // depends on had changed since the last one
+    long poseUpdates() const { return posesComputed; }
+    long poseSkips() const { return posesSkipped; }
+
+    // the gait baked from a default walker on first use
+    static const WalkCycle &walkCycle();
 
 private:
-    float t; // phase
-    Vector2 position;
-    float torsoLen, headRadius, baseY, speed, stride, lift, stepPeriod;
-    Limb2 leftLeg, rightLeg, leftArm, rightArm;
-    std::vector<Finger2> fingers;
-    Vector2 torsoTop, torsoBottom, headCenter;
+    float t = 0.0f; // phase
+    int phaseStep = 0; // steps into the current gait cycle, t = phaseStep * 2 pi / stepPeriod
+    Vector2 position{};
+    float torsoLen = 0.0f, headRadius = 0.0f, baseY = 0.0f, stride = 0.0f, lift = 0.0f;
+    float speed = 0.0f;      // px per tick, from kWalkSpeed
+    float stepPeriod = 1.0f; // ticks per gait cycle, from kStepPeriod
+    Limb2 leftLeg{}, rightLeg{}, leftArm{}, rightArm{};
+    std::array<Finger2, 3> fingers{};
+    Vector2 torsoTop{}, torsoBottom{}, headCenter{};
     Vector2 ballCenter;
     float ballRadius;
-    bool reached;
+    bool reached = false;
+    bool skeletonStale = true;
+    // bench/Benchmarks.cpp times the update stages one by one
+    friend struct WalkerStageBench;
+
+    void buildSkeleton();
+    void updateSkeleton();
     void updateTorso();
     void updateLegs();
     void updateArms();
     void updateFingers();
+    void applyPose(const WalkerPose &pose);
+
+    // everything a pose update reads that can change between ticks; the
+    // update is skipped while these match the last one, at that detail or
+    // coarser
+    struct PoseInputs
+    {
+        float t, x, windup, throwFwd;
+        Vector2 ball;
+        bool reached, standUp, walkCycle;
+        LodTier tier;
+    };
+    PoseInputs poseInputs(LodTier tier) const;
+    bool poseCurrent(const PoseInputs &in) const;
+    PoseInputs lastPose{};
+    bool poseValid = false;
+    long posesComputed = 0, posesSkipped = 0;
     // void reachForBall();
     bool standUp = false;
+    bool useWalkCycle = true;
+    bool usePoseCache = true;
     float throwWindupPhase = 0.0f;
     float throwFwdPhase = 0.0f;
 };
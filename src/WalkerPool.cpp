@@ -0,0 +1,349 @@
+#include "WalkerPool.h"
+#include "IK.h"
+#include "FastTrig.h"
+#include <algorithm>
+#include <cmath>
+
+// same tuning Walker::init uses for every walker
+static constexpr float kBaseY = 500.0f;
+static constexpr float kLegUpper = 46.0f, kLegLower = 44.0f;
+static constexpr float kArmUpper = 38.0f, kArmLower = 34.0f;
+static constexpr float kFingerLen = 10.0f;
+static constexpr float kStride = 22.0f;
+static constexpr float kLift = 8.0f;
+static constexpr float kTorsoLen = 80.0f;
+static constexpr float kHeadRadius = 18.0f;
+
+void WalkerPool::LimbArrays::resize(size_t n)
+{
+    for (auto *v : {&rootX, &rootY, &jointX, &jointY, &tipX, &tipY, &theta1, &theta2})
+        v->resize(n);
+}
+
+void WalkerPool::FingerArrays::resize(size_t n)
+{
+    for (auto *v : {&angle, &tipX, &tipY})
+        v->resize(n);
+}
+
+void WalkerPool::IKScratch::resize(size_t n)
+{
+    for (auto *v : {&rootX, &rootY, &targetX, &targetY, &bend,
+                    &theta1, &theta2, &jointX, &jointY, &tipX, &tipY})
+        v->resize(n);
+    index.resize(n);
+}
+
+WalkerPool::WalkerPool(size_t capacity, float tickDt)
+    : speed(Walker::speedPerTick(tickDt)), stepPeriod(Walker::stepsPerCycle(tickDt))
+{
+    resize(capacity);
+}
+
+void WalkerPool::resize(size_t n)
+{
+    for (auto *v : {&posX, &t, &ballX, &ballY, &ballR, &throwWindup, &throwFwd,
+                    &torsoBottomX, &torsoBottomY, &torsoTopX, &torsoTopY, &headX, &headY})
+        v->resize(n);
+    phaseStep.resize(n);
+    reached.resize(n);
+    standUp.resize(n);
+    for (auto *l : {&leftLeg, &rightLeg, &leftArm, &rightArm})
+        l->resize(n);
+    for (auto &f : fingers)
+        f.resize(n);
+    legUpper.assign(n, kLegUpper);
+    legLower.assign(n, kLegLower);
+    armUpper.assign(n, kArmUpper);
+    armLower.assign(n, kArmLower);
+    ik.resize(n);
+}
+
+size_t WalkerPool::add(Vector2 ballCenter, float ballRadius)
+{
+    if (count == posX.size())
+        resize(std::max<size_t>(64, count * 2));
+
+    size_t i = count++;
+    posX[i] = 100.0f;
+    t[i] = 0.0f;
+    phaseStep[i] = 0;
+    ballX[i] = ballCenter.x;
+    ballY[i] = ballCenter.y;
+    ballR[i] = ballRadius;
+    throwWindup[i] = 0.0f;
+    throwFwd[i] = 0.0f;
+    reached[i] = 0;
+    standUp[i] = 0;
+    return i;
+}
+
+void WalkerPool::clear()
+{
+    count = 0;
+}
+
+void WalkerPool::setStandUp(size_t i, bool value)
+{
+    standUp[i] = value;
+}
+
+void WalkerPool::setThrowAnim(size_t i, float windup, float throwFwd_)
+{
+    throwWindup[i] = windup;
+    throwFwd[i] = throwFwd_;
+}
+
+void WalkerPool::stepAll()
+{
+    advanceAll();
+    updateTorsoAll();
+    updateLegsAll();
+    updateArmsAll();
+    updateFingersAll();
+}
+
+void WalkerPool::advanceAll()
+{
+    const float dt = 2 * PI / static_cast<float>(stepPeriod);
+    for (size_t i = 0; i < count; ++i)
+    {
+        bool walking = !reached[i] && posX[i] < ballX[i] - 65;
+        posX[i] += walking ? speed : 0.0f;
+        if (walking)
+        {
+            phaseStep[i] = (phaseStep[i] + 1) % stepPeriod;
+            t[i] = phaseStep[i] * dt;
+        }
+        reached[i] = !walking;
+    }
+}
+
+void WalkerPool::updateTorsoAll()
+{
+    const float legLength = kLegUpper + kLegLower;
+    const float maxReach = kArmUpper + kArmLower + kFingerLen;
+    const float maxSquat = 38.0f;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        float bob = 3.0f * trig::sin(2 * t[i]);
+        float sway = 3.0f * trig::sin(t[i]);
+        torsoBottomX[i] = posX[i] + sway;
+        torsoBottomY[i] = kBaseY - legLength + 18.0f - bob;
+        torsoTopX[i] = torsoBottomX[i];
+        torsoTopY[i] = torsoBottomY[i] - kTorsoLen;
+    }
+
+    // crouch / lean towards the ball: only walkers that reached it and are not standing
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!reached[i] || standUp[i])
+            continue;
+
+        float dx = torsoBottomX[i] - ballX[i];
+        float dy = torsoBottomY[i] - kTorsoLen - ballY[i];
+        float dist = sqrtf(dx * dx + dy * dy);
+        if (dist <= maxReach)
+            continue;
+
+        torsoBottomY[i] += std::min(dist - maxReach, maxSquat);
+        dy = torsoBottomY[i] - kTorsoLen - ballY[i];
+        dist = sqrtf(dx * dx + dy * dy);
+
+        float torsoAngle = 0.0f;
+        if (dist > maxReach)
+            torsoAngle = std::clamp(trig::atan2(ballX[i] - torsoBottomX[i], ballY[i] - torsoBottomY[i]), -0.7f, 0.7f);
+
+        torsoTopX[i] = torsoBottomX[i] + kTorsoLen * trig::sin(torsoAngle);
+        torsoTopY[i] = torsoBottomY[i] - kTorsoLen * trig::cos(torsoAngle);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        headX[i] = torsoTopX[i];
+        headY[i] = torsoTopY[i] - kHeadRadius - 4;
+    }
+}
+
+void WalkerPool::updateLegsAll()
+{
+    constexpr float stanceDuration = 0.6f;
+    constexpr float swingStart = 2 * PI * (1 - stanceDuration);
+
+    auto solve = [this](LimbArrays &leg, float hipOffset, float phaseOffset, float side)
+    {
+        // foot placement from the gait phase; the foot is the IK target
+        for (size_t i = 0; i < count; ++i)
+        {
+            float normPhase = fmod(fmod(t[i], 2 * PI) + phaseOffset, 2 * PI);
+
+            float stepX = side, stepY = kBaseY, kneeBend;
+            if (normPhase < swingStart)
+            {
+                float swingNorm = normPhase / swingStart;
+                stepX = side + kStride * (2 * swingNorm - 1);
+                stepY = kBaseY - kLift * trig::sin(PI * swingNorm);
+                kneeBend = 0.9f * (1 - swingNorm);
+            }
+            else
+            {
+                kneeBend = 0.2f * (1 - trig::cos(PI * (normPhase - swingStart) / (2 * PI * stanceDuration)));
+            }
+            leg.rootX[i] = torsoBottomX[i] + hipOffset;
+            leg.rootY[i] = torsoBottomY[i];
+            leg.tipX[i] = posX[i] + stepX;
+            leg.tipY[i] = stepY;
+            ik.bend[i] = kneeBend;
+        }
+
+        // the foot stays pinned to its target, so the solver's own tip is discarded
+        TwoBoneBatch batch = {leg.rootX.data(), leg.rootY.data(), leg.tipX.data(), leg.tipY.data(),
+                              legUpper.data(), legLower.data(), ik.bend.data(),
+                              leg.theta1.data(), leg.theta2.data(), leg.jointX.data(), leg.jointY.data(),
+                              ik.tipX.data(), ik.tipY.data()};
+        solveTwoBoneBatch(batch, count);
+    };
+
+    solve(leftLeg, -12.0f, 0.0f, -13.0f);
+    solve(rightLeg, 12.0f, PI, 13.0f);
+}
+
+void WalkerPool::updateArmsAll()
+{
+    auto forward = [](LimbArrays &arm, size_t i, float rootX, float rootY, float theta1, float theta2)
+    {
+        arm.rootX[i] = rootX;
+        arm.rootY[i] = rootY;
+        arm.theta1[i] = theta1;
+        arm.theta2[i] = theta2;
+        arm.jointX[i] = rootX + kArmUpper * trig::sin(theta1);
+        arm.jointY[i] = rootY + kArmUpper * trig::cos(theta1);
+        arm.tipX[i] = arm.jointX[i] + kArmLower * trig::sin(theta1 + theta2);
+        arm.tipY[i] = arm.jointY[i] + kArmLower * trig::cos(theta1 + theta2);
+    };
+
+    // walking / idle swing
+    for (size_t i = 0; i < count; ++i)
+    {
+        float shoulderY = torsoTopY[i] + 5;
+        forward(leftArm, i, torsoTopX[i] - 18, shoulderY,
+                -1.2f + 0.8f * trig::sin(t[i] + PI), 0.4f * trig::sin(t[i] + 0.5f));
+        forward(rightArm, i, torsoTopX[i] + 18, shoulderY,
+                1.2f + 0.8f * trig::sin(t[i]), 0.4f * trig::sin(t[i] + PI + 0.5f));
+    }
+
+    // throw animation overrides both arms
+    for (size_t i = 0; i < count; ++i)
+    {
+        float windup = throwWindup[i], fwd = throwFwd[i];
+        if (windup > 0.0f || fwd > 0.0f)
+        {
+            const float baseAngle = 1.1f, windupAngle = 2.5f, throwAngle = -0.9f;
+            float swing = fwd > 0.0f ? (1.0f - fwd) * windupAngle + fwd * throwAngle
+                                     : (1.0f - windup) * baseAngle + windup * windupAngle;
+            float bend = 0.15f * (fwd > 0.0f ? -trig::sin(PI * fwd) : trig::sin(windup));
+            forward(rightArm, i, rightArm.rootX[i], rightArm.rootY[i], swing, bend);
+            forward(leftArm, i, leftArm.rootX[i], leftArm.rootY[i], -1.2f, 0.0f);
+        }
+    }
+
+    // reaching arms: gather, solve as one batch, scatter back
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!reached[i] || throwWindup[i] > 0.0f || throwFwd[i] > 0.0f)
+            continue;
+        ik.index[n] = i;
+        ik.rootX[n] = rightArm.rootX[i];
+        ik.rootY[n] = rightArm.rootY[i];
+        ik.targetX[n] = ballX[i];
+        ik.targetY[n] = ballY[i];
+        ik.bend[n] = -1.0f;
+        ++n;
+    }
+
+    TwoBoneBatch batch = {ik.rootX.data(), ik.rootY.data(), ik.targetX.data(), ik.targetY.data(),
+                          armUpper.data(), armLower.data(), ik.bend.data(),
+                          ik.theta1.data(), ik.theta2.data(), ik.jointX.data(), ik.jointY.data(),
+                          ik.tipX.data(), ik.tipY.data()};
+    solveTwoBoneBatch(batch, n);
+
+    for (size_t k = 0; k < n; ++k)
+    {
+        size_t i = ik.index[k];
+        rightArm.theta1[i] = ik.theta1[k];
+        rightArm.theta2[i] = ik.theta2[k];
+        rightArm.jointX[i] = ik.jointX[k];
+        rightArm.jointY[i] = ik.jointY[k];
+        rightArm.tipX[i] = ik.tipX[k];
+        rightArm.tipY[i] = ik.tipY[k];
+    }
+}
+
+void WalkerPool::updateFingersAll()
+{
+    for (int f = 0; f < 3; ++f)
+    {
+        FingerArrays &fa = fingers[f];
+        for (size_t i = 0; i < count; ++i)
+        {
+            float spread = reached[i] ? 0.5f : 0.28f;
+            float angle = rightArm.theta1[i] + rightArm.theta2[i] + (f - 1) * spread;
+            fa.angle[i] = angle;
+            fa.tipX[i] = rightArm.tipX[i] + kFingerLen * trig::sin(angle);
+            fa.tipY[i] = rightArm.tipY[i] + kFingerLen * trig::cos(angle);
+        }
+    }
+}
+
+WalkerPose WalkerPool::pose(size_t i) const
+{
+    auto limb = [i](const LimbArrays &l, float len1, float len2)
+    {
+        Limb2 out;
+        out.root = {l.rootX[i], l.rootY[i]};
+        out.len1 = len1;
+        out.len2 = len2;
+        out.theta1 = l.theta1[i];
+        out.theta2 = l.theta2[i];
+        out.joint = {l.jointX[i], l.jointY[i]};
+        out.tip = {l.tipX[i], l.tipY[i]};
+        return out;
+    };
+
+    WalkerPose p;
+    p.torsoBottom = {torsoBottomX[i], torsoBottomY[i]};
+    p.torsoTop = {torsoTopX[i], torsoTopY[i]};
+    p.headCenter = {headX[i], headY[i]};
+    p.headRadius = kHeadRadius;
+    p.leftLeg = limb(leftLeg, kLegUpper, kLegLower);
+    p.rightLeg = limb(rightLeg, kLegUpper, kLegLower);
+    p.leftArm = limb(leftArm, kArmUpper, kArmLower);
+    p.rightArm = limb(rightArm, kArmUpper, kArmLower);
+    for (int f = 0; f < 3; ++f)
+    {
+        p.fingers[f].root = p.rightArm.tip;
+        p.fingers[f].len = kFingerLen;
+        p.fingers[f].angle = fingers[f].angle[i];
+        p.fingers[f].tip = {fingers[f].tipX[i], fingers[f].tipY[i]};
+    }
+    return p;
+}
+
+Vector2 WalkerPool::getHandPos(size_t i) const
+{
+    return {rightArm.tipX[i], rightArm.tipY[i]};
+}
+
+bool WalkerPool::fingersTouchingBall(size_t i) const
+{
+    float r = ballR[i] + 1.0f;
+    int touching = 0;
+    for (const auto &f : fingers)
+    {
+        float dx = f.tipX[i] - ballX[i], dy = f.tipY[i] - ballY[i];
+        touching += dx * dx + dy * dy <= r * r;
+    }
+    return touching == 3;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "raylib.h"
+#include "Walker.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Structure-of-arrays crowd of walkers. Every walker runs the same logic as
+// Walker::step, but each field lives in its own contiguous array so stepAll()
+// can sweep the whole batch one stage at a time.
+class WalkerPool
+{
+public:
+    // walkers stepped every tickDt seconds, as Walker::init takes it
+    explicit WalkerPool(size_t capacity = 0, float tickDt = 1.0f / 60.0f);
+
+    // equivalent to Walker(ballCenter, ballRadius) followed by init(100, tickDt)
+    size_t add(Vector2 ballCenter, float ballRadius);
+    void clear();
+    size_t size() const { return count; }
+
+    void setStandUp(size_t i, bool value);
+    void setThrowAnim(size_t i, float windup, float throwFwd);
+
+    void stepAll();
+
+    WalkerPose pose(size_t i) const;
+    Vector2 getHandPos(size_t i) const;
+    bool fingersTouchingBall(size_t i) const;
+
+private:
+    struct LimbArrays
+    {
+        std::vector<float> rootX, rootY, jointX, jointY, tipX, tipY, theta1, theta2;
+        void resize(size_t n);
+    };
+
+    struct FingerArrays
+    {
+        std::vector<float> angle, tipX, tipY;
+        void resize(size_t n);
+    };
+
+    // gather buffers for the batched IK solves
+    struct IKScratch
+    {
+        std::vector<float> rootX, rootY, targetX, targetY, bend;
+        std::vector<float> theta1, theta2, jointX, jointY, tipX, tipY;
+        std::vector<size_t> index;
+        void resize(size_t n);
+    };
+
+    void resize(size_t n);
+    void advanceAll();
+    void updateTorsoAll();
+    void updateLegsAll();
+    void updateArmsAll();
+    void updateFingersAll();
+
+    size_t count = 0;
+    float speed;    // px per tick, from Walker::kWalkSpeed
+    int stepPeriod; // ticks per gait cycle, from Walker::kStepPeriod
+
+    // per-walker inputs
+    std::vector<float> posX, t;
+    std::vector<int32_t> phaseStep; // steps into the current gait cycle
+    std::vector<float> ballX, ballY, ballR;
+    std::vector<float> throwWindup, throwFwd;
+    std::vector<uint8_t> reached, standUp;
+
+    // pose
+    std::vector<float> torsoBottomX, torsoBottomY, torsoTopX, torsoTopY, headX, headY;
+    LimbArrays leftLeg, rightLeg, leftArm, rightArm;
+    FingerArrays fingers[3];
+
+    // bone lengths as arrays so they feed solveTwoBoneBatch directly
+    std::vector<float> legUpper, legLower, armUpper, armLower;
+    IKScratch ik;
+};
@@ -0,0 +1,114 @@
+#include "World.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+static constexpr float kRoundWidth = 900.0f;  // a CrowdScene round, local px
+static constexpr float kRoundGround = 500.0f; // its ground line
+static constexpr float kBackLift = 60.0f;     // bystanders stand this far up the screen
+
+World::World(float regionWidth, float groundY, int regions, uint32_t seed)
+    : regionWidth(regionWidth), groundY(groundY), regionCount(std::max(regions, 1)),
+      scale(regionWidth / (kRoundWidth * kRoundsPerRegion)),
+      crowd(regionCount > 1 ? regionCount * kRoundsPerRegion : 0, seed)
+{
+    for (size_t i = 0; i < crowd.size(); ++i)
+        crowd.setDetail(i, LOD_SILHOUETTE);
+}
+
+Vector2 World::offsetOf(size_t i) const
+{
+    size_t region = i / kRoundsPerRegion, slot = i % kRoundsPerRegion;
+    return {region * regionWidth + slot * regionWidth / kRoundsPerRegion, groundY - kBackLift};
+}
+
+World::Range World::roundsNear(float left, float right) const
+{
+    int r0 = std::max(static_cast<int>(std::floor(left / regionWidth)) - 1, 0);
+    int r1 = std::min(static_cast<int>(std::floor(right / regionWidth)) + 1, regionCount - 1);
+    if (crowd.size() == 0 || r0 > r1)
+        return {0, 0};
+    return {r0 * kRoundsPerRegion, (r1 + 1) * kRoundsPerRegion};
+}
+
+void World::step(JobSystem &jobs, float viewLeft, float viewRight)
+{
+    if (crowd.size() == 0)
+        return;
+    PROFILE_ZONE("world.step");
+    Range near = roundsNear(viewLeft, viewRight);
+    if (near.begin != detailed.begin || near.end != detailed.end)
+    {
+        for (size_t i = detailed.begin; i < detailed.end; ++i)
+            crowd.setDetail(i, LOD_SILHOUETTE);
+        for (size_t i = near.begin; i < near.end; ++i)
+            crowd.setDetail(i, LOD_MEDIUM);
+        detailed = near;
+    }
+    crowd.step(jobs);
+}
+
+void World::gather(float viewLeft, float viewRight, std::vector<BystanderView> &out, CullStats &stats) const
+{
+    PROFILE_ZONE("world.cull");
+    Range near = roundsNear(viewLeft, viewRight);
+    stats.skipped += 3 * static_cast<long>(crowd.size() - (near.end - near.begin));
+    auto inView = [&](float minX, float maxX)
+    { return maxX >= viewLeft && minX <= viewRight; };
+
+    const BallSystem &balls = crowd.balls();
+    for (size_t i = near.begin; i < near.end; ++i)
+    {
+        Vector2 at = offsetOf(i);
+        auto map = [&](Vector2 p) -> Vector2
+        { return {p.x * scale + at.x, (p.y - kRoundGround) * scale + at.y}; };
+
+        BystanderView b;
+        b.pose = crowd.walker(i).getPose();
+        transformPose(b.pose, {0.0f, kRoundGround}, scale, at);
+        float minX, maxX;
+        poseExtentX(b.pose, minX, maxX);
+        b.drawWalker = inView(minX, maxX);
+
+        Vector2 ball = map(balls.getPos(i));
+        b.ball = {ball.x, ball.y, balls.getRadius(i) * scale};
+        b.drawBall = inView(b.ball.x - b.ball.radius, b.ball.x + b.ball.radius);
+
+        const Circle &t = crowd.target(i);
+        Vector2 target = map({t.x, t.y});
+        b.target = {target.x, target.y, t.radius * scale};
+        bool hasTarget = crowd.targetActive(i);
+        b.drawTarget = hasTarget && inView(b.target.x - b.target.radius, b.target.x + b.target.radius);
+
+        stats.walkersDrawn += b.drawWalker;
+        stats.ballsDrawn += b.drawBall;
+        stats.targetsDrawn += b.drawTarget;
+        // a target that is not up yet was never a candidate
+        stats.culled += !b.drawWalker + !b.drawBall + (hasTarget && !b.drawTarget);
+        if (b.drawWalker || b.drawBall || b.drawTarget)
+            out.push_back(b);
+    }
+}
+
+// behind the player's round, which uses layers 0 to 2
+void World::draw(const std::vector<BystanderView> &bystanders, std::vector<Target> &targets, PrimitiveBatch &batch)
+{
+    targets.clear();
+    for (const BystanderView &b : bystanders)
+    {
+        if (b.drawWalker)
+        {
+            batch.setLayer(-3);
+            Walker::draw(b.pose, batch, LOD_MEDIUM);
+        }
+        if (b.drawBall)
+        {
+            batch.setLayer(-2);
+            batch.circle({b.ball.x, b.ball.y}, b.ball.radius, ORANGE);
+        }
+        if (b.drawTarget)
+            targets.push_back(Target({b.target.x, b.target.y}, b.target.radius, RED));
+    }
+    batch.setLayer(-1);
+    Target::drawAll(targets.data(), targets.size(), batch);
+}
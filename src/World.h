@@ -0,0 +1,94 @@
+#pragma once
+#include "raylib.h"
+#include "CrowdScene.h"
+#include "JobSystem.h"
+#include "PrimitiveBatch.h"
+#include "Shapes.h"
+#include "Target.h"
+#include "Walker.h"
+#include <cstdint>
+#include <vector>
+
+// what one frame's culling did: entities drawn, entities tested against
+// the view and rejected (a round's target only while it is up), and
+// entity slots in regions the view does not touch, which are never
+// looked at
+struct CullStats
+{
+    long walkersDrawn = 0;
+    long ballsDrawn = 0;
+    long targetsDrawn = 0;
+    long culled = 0;
+    long skipped = 0;
+
+    long drawn() const { return walkersDrawn + ballsDrawn + targetsDrawn; }
+    CullStats &operator+=(const CullStats &o)
+    {
+        walkersDrawn += o.walkersDrawn;
+        ballsDrawn += o.ballsDrawn;
+        targetsDrawn += o.targetsDrawn;
+        culled += o.culled;
+        skipped += o.skipped;
+        return *this;
+    }
+};
+
+// one bystander round as the renderer needs it, in world space
+struct BystanderView
+{
+    WalkerPose pose;
+    Circle ball;
+    Circle target;
+    bool drawWalker, drawBall, drawTarget;
+};
+
+// The strip of ground the game is played on, `regions` screens wide, and
+// the bystanders that fill it: kRoundsPerRegion CrowdScene rounds per
+// region, drawn at half size behind the player.
+//
+// Rounds are stored in region order, so the rounds of regions [a, b] are
+// one contiguous index range and culling only ever looks at the regions
+// the view touches. A one-region world has no bystanders.
+class World
+{
+public:
+    static constexpr size_t kRoundsPerRegion = 2;
+
+    World(float regionWidth, float groundY, int regions, uint32_t seed);
+
+    float width() const { return regionWidth * regionCount; }
+    int regions() const { return regionCount; }
+    size_t bystanders() const { return crowd.size(); }
+
+    // one tick of every bystander: rounds near the view at LOD_MEDIUM,
+    // the rest at LOD_SILHOUETTE
+    void step(JobSystem &jobs, float viewLeft, float viewRight);
+    // appends every bystander with something inside [viewLeft, viewRight]
+    void gather(float viewLeft, float viewRight, std::vector<BystanderView> &out, CullStats &stats) const;
+    // walkers and balls one by one, then every target through
+    // Target::drawAll; `targets` is the caller's buffer, kept between frames
+    static void draw(const std::vector<BystanderView> &bystanders, std::vector<Target> &targets,
+                     PrimitiveBatch &batch);
+
+    // most rounds gather() can return: a view less than twice a region
+    // wide touches three, plus one on each side
+    size_t maxVisible() const { return 5 * kRoundsPerRegion; }
+    uint64_t stateHash() const { return crowd.stateHash(); }
+
+private:
+    struct Range
+    {
+        size_t begin, end;
+    };
+    // rounds of the regions overlapping [left, right], plus one region on
+    // each side for balls and arms that reach past their own
+    Range roundsNear(float left, float right) const;
+    Vector2 offsetOf(size_t i) const;
+
+    float regionWidth;
+    float groundY;
+    int regionCount;
+    float scale;
+    CrowdScene crowd;
+    Range detailed = {0, 0}; // rounds currently at LOD_MEDIUM
+};
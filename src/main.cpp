@@ -1,8 +1,187 @@
 #include "Game.h"
+#include "StressScene.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
-int main()
+// --check-allocs: fails the run if the steady state touched the heap
+static int checkAllocations(const HeadlessStats &s)
 {
-    Game game(900, 600);
-    game.run();
-    return 0;
+    if (s.steadyAllocations < 0)
+    {
+        std::fprintf(stderr, "allocation check needs a build with OOCATCHER_TRACK_ALLOCS and at least one reset\n");
+        return 1;
+    }
+    std::printf("steady state: %ld heap allocations in %ld frames\n", s.steadyAllocations, s.steadyFrames);
+    return s.steadyAllocations == 0 ? 0 : 1;
+}
+
+// per-frame averages of what culling drew and dropped
+static void printCulling(const Game &game, const HeadlessStats &s)
+{
+    if (s.frames == 0)
+        return;
+    double n = static_cast<double>(s.frames);
+    std::printf("          world %d screens, %zu bystanders; per frame drew %.1f walkers, %.1f balls, "
+                "%.1f targets, culled %.1f, skipped %.1f\n",
+                game.worldScreens(), game.bystanders(), s.cull.walkersDrawn / n, s.cull.ballsDrawn / n,
+                s.cull.targetsDrawn / n, s.cull.culled / n, s.cull.skipped / n);
+}
+
+static void printStress(const StressScene &scene, const StressStats &s)
+{
+    std::printf("stress: %zu walkers, %ld frames\n", scene.size(), s.frames);
+    std::printf("        per frame: sim %.3f ms, lod %.3f ms, draw %.3f ms, worst frame %.3f ms\n",
+                s.simMs, s.lodMs, s.drawMs, s.maxFrameMs);
+    std::printf("        walkers per tier:");
+    for (int t = 0; t < LOD_TIERS; ++t)
+        std::printf(" %s %.0f", lodName(static_cast<LodTier>(t)), s.tiers[t]);
+    std::printf(" (off screen %.0f, tier changes %.1f/frame)\n", s.offscreen, s.tierChanges);
+    std::printf("        %ld throws, %ld hits\n", s.crowd.throws, s.crowd.hits);
+}
+
+// usage: OOCatcher [--tick-rate hz] [--max-substeps n] [--fps n] [--threaded] [--profile file]
+//                  [--seed n] [--record file] [--world screens]
+//        OOCatcher --headless [frames] [--dt seconds] [--profile file] [--seed n] [--record file]
+//                  [--world screens] [--check-allocs] [--render file] [--render-every n]
+//                  [--render-threads n]
+//        OOCatcher --replay file [--profile file] [--check-allocs]
+//        OOCatcher --stress walkers [--headless [frames]] [--seed n]
+int main(int argc, char **argv)
+{
+    bool headless = false;
+    long frames = 100000;
+    float dt = 1.0f / rounds::kTickRate;
+    float tickRate = rounds::kTickRate;
+    int maxSubsteps = 5;
+    int fps = 60;
+    bool threaded = false;
+    const char *traceFile = nullptr;
+    const char *recordFile = nullptr;
+    const char *replayFile = nullptr;
+    uint64_t seed = Game::timeSeed();
+    bool checkAllocs = false;
+    long stress = 0;
+    int worldScreens = 1;
+    const char *renderFile = nullptr;
+    int renderEvery = 1;
+    unsigned renderThreads = 0;
+    bool framesGiven = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--headless") == 0)
+        {
+            headless = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+            {
+                frames = std::atol(argv[++i]);
+                framesGiven = true;
+            }
+        }
+        else if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc)
+            dt = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc)
+            tickRate = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--max-substeps") == 0 && i + 1 < argc)
+            maxSubsteps = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+            fps = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--threaded") == 0)
+            threaded = true;
+        else if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc)
+            traceFile = argv[++i];
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+            recordFile = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+            replayFile = argv[++i];
+        else if (std::strcmp(argv[i], "--check-allocs") == 0)
+            checkAllocs = true;
+        else if (std::strcmp(argv[i], "--render") == 0 && i + 1 < argc)
+            renderFile = argv[++i];
+        else if (std::strcmp(argv[i], "--render-every") == 0 && i + 1 < argc)
+            renderEvery = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--render-threads") == 0 && i + 1 < argc)
+            renderThreads = static_cast<unsigned>(std::max(std::atoi(argv[++i]), 0));
+        else if (std::strcmp(argv[i], "--world") == 0 && i + 1 < argc)
+            worldScreens = std::max(std::atoi(argv[++i]), 1);
+        else if (std::strcmp(argv[i], "--stress") == 0 && i + 1 < argc)
+            stress = std::atol(argv[++i]);
+    }
+
+    if (stress > 0)
+    {
+        JobSystem jobs;
+        StressScene scene(static_cast<size_t>(stress), static_cast<uint32_t>(seed), 1280, 720);
+        if (!headless)
+        {
+            scene.run(jobs);
+            return 0;
+        }
+        printStress(scene, scene.runHeadless(jobs, framesGiven ? frames : 600));
+        return 0;
+    }
+
+    if (replayFile)
+    {
+        InputLog log;
+        if (!log.load(replayFile))
+        {
+            std::fprintf(stderr, "could not read input log '%s'\n", replayFile);
+            return 1;
+        }
+        Game game(rounds::kScreenW, rounds::kScreenH, true, log.seed(), log.worldScreens());
+        if (traceFile)
+            game.setTraceFile(traceFile);
+        HeadlessStats s = game.runReplay(log);
+        uint64_t hash = game.stateHash();
+        std::printf("replay: %ld ticks (%.1f s simulated, %zu inputs) in %.3f s wall, %.0f ticks/s\n",
+                    s.frames, s.simSeconds, log.inputCount(), s.wallSeconds,
+                    s.wallSeconds > 0.0 ? s.frames / s.wallSeconds : 0.0);
+        std::printf("        state hash %016llx, recorded %016llx: %s\n",
+                    static_cast<unsigned long long>(hash), static_cast<unsigned long long>(log.finalHash()),
+                    hash == log.finalHash() ? "match" : "MISMATCH");
+        if (hash != log.finalHash())
+            return 1;
+        return checkAllocs ? checkAllocations(s) : 0;
+    }
+
+    Game game(rounds::kScreenW, rounds::kScreenH, headless, seed, worldScreens);
+    game.setTickRate(tickRate);
+    game.setMaxSubsteps(maxSubsteps);
+    game.setRenderFps(fps);
+    game.setThreaded(threaded);
+    if (traceFile)
+        game.setTraceFile(traceFile);
+    if (recordFile)
+        game.setRecordFile(recordFile);
+    if (!headless)
+    {
+        game.run();
+        return 0;
+    }
+
+    if (renderFile)
+        game.setRenderOutput(renderFile, renderEvery, renderThreads);
+    HeadlessStats s = game.runHeadless(frames, dt);
+    std::printf("headless: %ld frames (%.1f s simulated) in %.3f s wall\n",
+                s.frames, s.simSeconds, s.wallSeconds);
+    std::printf("          %.0f simulated frames/s, %d throws, %d target hits, %d resets\n",
+                s.wallSeconds > 0.0 ? s.frames / s.wallSeconds : 0.0, s.throws, s.hits, s.resets);
+    printCulling(game, s);
+    std::printf("          player walker: %ld pose updates, %ld skipped as unchanged\n", s.poseUpdates, s.poseSkips);
+    if (s.renderedFrames > 0)
+        std::printf("          rendered and saved %ld frames on the CPU (%s), %.3f ms each, last image checksum %016llx\n",
+                    s.renderedFrames, SoftwareRenderer::simdName(), s.renderSeconds * 1000.0 / s.renderedFrames,
+                    static_cast<unsigned long long>(s.imageChecksum));
+    int status = checkAllocs ? checkAllocations(s) : 0;
+    if (s.failedSaves > 0)
+    {
+        std::fprintf(stderr, "%ld rendered frames could not be saved\n", s.failedSaves);
+        status = 1;
+    }
+    return status;
 }
@@ -0,0 +1,175 @@
+#include "ThrowTuner.h"
+#include "Ball.h"
+#include "Rng.h"
+#include "Round.h"
+#include "StateHash.h"
+#include "Target.h"
+#include "Walker.h"
+#include <algorithm>
+
+static constexpr size_t kLayoutsPerChunk = 8;
+static constexpr long kLayoutsPerBatch = 4096; // bounds chunkTotals
+
+ThrowTuner::ThrowTuner(const ThrowGrid &grid, uint64_t seed, bool useSolver)
+    : points(grid), seed(seed), useSolver(useSolver), totals(grid.size())
+{
+    solvers.reserve(grid.gravity.size());
+    for (float g : grid.gravity)
+    {
+        ThrowConstraints c;
+        c.gravity = g;
+        solvers.emplace_back(c);
+    }
+}
+
+float ThrowTuner::tickDt()
+{
+    return 1.0f / rounds::kTickRate;
+}
+
+void ThrowTuner::run(long layouts, JobSystem &jobs)
+{
+    const size_t n = points.size();
+    for (long done = 0; done < layouts; done += kLayoutsPerBatch)
+    {
+        long count = std::min(kLayoutsPerBatch, layouts - done);
+        size_t chunks = (static_cast<size_t>(count) + kLayoutsPerChunk - 1) / kLayoutsPerChunk;
+        chunkTotals.assign(chunks * n, ThrowTally{});
+        long first = layoutsRun + done;
+        jobs.parallelFor(static_cast<size_t>(count), kLayoutsPerChunk, [&](size_t begin, size_t end)
+                         { runLayouts(first + static_cast<long>(begin), static_cast<long>(end - begin),
+                                      &chunkTotals[begin / kLayoutsPerChunk * n]); });
+        for (size_t c = 0; c < chunks; ++c)
+            for (size_t p = 0; p < n; ++p)
+                totals[p] += chunkTotals[c * n + p];
+    }
+    layoutsRun += layouts;
+}
+
+void ThrowTuner::runLayouts(long first, long count, ThrowTally *out) const
+{
+    const float dt = tickDt();
+    const long maxTicks = rounds::maxTicks(dt); // Game's autopilot resets after this
+    const size_t gravities = points.gravity.size(), times = points.flightTime.size();
+    const size_t durations = points.throwAnimDuration.size();
+    Ball ball({0.0f, 0.0f}, 1.0f, WHITE); // reused, its impact list stays inline
+
+    for (long i = first; i < first + count; ++i)
+    {
+        Rng rng(splitmix64(seed + static_cast<uint64_t>(i)));
+
+        // Game's first round in a one-screen world
+        Ball layout = rounds::randomBall(rng, rounds::kStartX, rounds::kScreenW, rounds::kGroundY);
+        const float r = layout.getRadius();
+
+        // walk until the fingers close on the ball; the autopilot asks to
+        // stand on the next tick, which is when the target appears
+        Walker walker(layout.getPos(), r);
+        walker.init(rounds::kStartX, dt);
+        long tick = 0;
+        bool touched = false, standing = false;
+        while (!standing && tick < maxTicks)
+        {
+            ++tick;
+            standing = touched;
+            if (!touched && walker.fingersTouchingBall())
+                touched = true;
+            walker.setStandUp(standing);
+            walker.step();
+        }
+        if (!standing)
+        {
+            for (size_t p = 0; p < points.size(); ++p)
+            {
+                ++out[p].episodes;
+                ++out[p].timeouts;
+                out[p].ticks += maxTicks;
+            }
+            continue;
+        }
+
+        // the camera at the left end of the world
+        Target target = rounds::randomTarget(rng, 0.0f, rounds::kScreenW, rounds::kGroundY);
+        Circle aim = target.bounds();
+
+        for (size_t a = 0; a < durations; ++a)
+        {
+            // as Game::update: the hand at release is the pose stepped
+            // with the previous tick's phase
+            Walker thrower = walker;
+            long release = tick;
+            float animTime = 0.0f, phase = 0.0f;
+            while (phase < 1.0f && release < maxTicks)
+            {
+                ++release;
+                thrower.step();
+                animTime += dt;
+                phase = std::min(animTime / points.throwAnimDuration[a], 1.0f);
+                thrower.setThrowAnim(1.0f, phase);
+            }
+            Vector2 hand = thrower.getHandPos();
+
+            for (size_t g = 0; g < gravities; ++g)
+            {
+                float gravity = points.gravity[g];
+                ThrowSolution shot{};
+                if (useSolver)
+                    shot = solvers[g].solve(hand, target.getPos());
+
+                // a feasible solved throw ignores flightTime: fly it once
+                ThrowTally flown;
+                for (size_t f = 0; f < times; ++f)
+                {
+                    ThrowTally &t = out[points.index(g, f, a)];
+                    if (f > 0 && shot.feasible)
+                    {
+                        t += flown;
+                        continue;
+                    }
+                    flown = ThrowTally{};
+                    flown.episodes = 1;
+                    flown.releaseTicks = release - tick;
+                    if (phase < 1.0f)
+                    {
+                        flown.timeouts = 1;
+                        flown.ticks = maxTicks;
+                        t += flown;
+                        continue;
+                    }
+                    flown.fallbacks = useSolver && !shot.feasible;
+
+                    // the first flight update runs in the release tick
+                    ball.radius = r;
+                    ball.throwTo(hand, target.getPos(), gravity, shot.feasible ? shot.time : points.flightTime[f]);
+                    ball.predict(rounds::kGroundY, &aim, 1);
+                    long landed = release;
+                    for (;; ++landed)
+                    {
+                        if (landed > maxTicks)
+                        {
+                            flown.timeouts = 1;
+                            landed = maxTicks;
+                            break;
+                        }
+                        ball.update(gravity, dt, rounds::kGroundY);
+                        if (ball.hitTarget >= 0)
+                            flown.hits = 1;
+                        if (ball.getPos().y >= rounds::kGroundY - r)
+                            break;
+                    }
+                    flown.flightTicks = landed - release + 1;
+                    flown.ticks = landed;
+                    t += flown;
+                }
+            }
+        }
+    }
+}
+
+uint64_t ThrowTuner::resultHash() const
+{
+    StateHash h;
+    for (const ThrowTally &t : totals)
+        h.add(t);
+    return h.value;
+}
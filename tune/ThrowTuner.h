@@ -0,0 +1,85 @@
+#pragma once
+#include "JobSystem.h"
+#include "ThrowSolver.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The three throw constants Game hard-codes, swept as a grid. Every
+// combination of the listed values is one grid point; index them with
+// at(), throwAnimDuration varying fastest.
+struct ThrowGrid
+{
+    std::vector<float> gravity{500.0f, 625.0f, 750.0f, 875.0f, 1000.0f};
+    std::vector<float> flightTime{0.6f, 0.75f, 0.9f, 1.05f, 1.2f};
+    std::vector<float> throwAnimDuration{0.2f, 0.3f, 0.4f, 0.5f, 0.6f};
+
+    size_t size() const { return gravity.size() * flightTime.size() * throwAnimDuration.size(); }
+    size_t index(size_t g, size_t f, size_t a) const
+    {
+        return (g * flightTime.size() + f) * throwAnimDuration.size() + a;
+    }
+};
+
+// One grid point summed over every layout. Times are whole ticks, so the
+// totals are exact and do not depend on the order layouts finish in.
+struct ThrowTally
+{
+    long episodes = 0;
+    long hits = 0;
+    long fallbacks = 0; // no throw fit ThrowConstraints, thrown with flightTime
+    long timeouts = 0;  // still going when Game's autopilot would reset
+    long ticks = 0;     // spawn to ball at rest
+    long releaseTicks = 0; // stand to release
+    long flightTicks = 0;
+
+    void operator+=(const ThrowTally &o)
+    {
+        episodes += o.episodes;
+        hits += o.hits;
+        fallbacks += o.fallbacks;
+        timeouts += o.timeouts;
+        ticks += o.ticks;
+        releaseTicks += o.releaseTicks;
+        flightTicks += o.flightTicks;
+    }
+};
+
+// Plays complete rounds the way Game's headless autopilot does: a ball and
+// target laid out by rounds::randomBall()/randomTarget() in a one-screen world,
+// the walker walks to the ball and grabs it, stands the next tick and
+// starts the throw the tick after, at rounds::kTickRate.
+//
+// The walk does not depend on the grid, so each layout walks once; the
+// throw animation runs once per throwAnimDuration from a copy of the
+// standing walker, and the release point is reused for every gravity and
+// flight time. Layout i is seeded from (seed, i) alone, so the results are
+// the same for any thread count.
+class ThrowTuner
+{
+public:
+    // `useSolver` false throws every ball with flightTime, as Game did
+    // before ThrowSolver
+    ThrowTuner(const ThrowGrid &grid, uint64_t seed, bool useSolver = true);
+
+    // adds `layouts` more rounds at every grid point
+    void run(long layouts, JobSystem &jobs);
+
+    const ThrowGrid &grid() const { return points; }
+    const std::vector<ThrowTally> &results() const { return totals; }
+    long layouts() const { return layoutsRun; }
+    static float tickDt();
+    // FNV-1a over every tally
+    uint64_t resultHash() const;
+
+private:
+    void runLayouts(long first, long count, ThrowTally *out) const;
+
+    ThrowGrid points;
+    uint64_t seed;
+    bool useSolver;
+    std::vector<ThrowSolver> solvers; // one per gravity
+    std::vector<ThrowTally> totals;
+    std::vector<ThrowTally> chunkTotals; // per chunk of the batch in flight
+    long layoutsRun = 0;
+};
@@ -0,0 +1,198 @@
+#include "ThrowTuner.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    struct Options
+    {
+        long layouts = 20000;
+        uint64_t seed = 1;
+        unsigned threads = 0; // one per hardware thread
+        bool useSolver = true;
+        bool verify = false;
+        const char *csvPath = nullptr;
+        ThrowGrid grid;
+    };
+
+    // "500,750,1000"; false on anything but a list of positive numbers
+    bool parseList(const char *text, std::vector<float> &out)
+    {
+        out.clear();
+        for (const char *p = text; *p;)
+        {
+            char *end = nullptr;
+            float v = std::strtof(p, &end);
+            if (end == p || !(v > 0.0f) || (*end && *end != ','))
+                return false;
+            out.push_back(v);
+            p = *end ? end + 1 : end;
+        }
+        return !out.empty();
+    }
+
+    double rate(long part, long whole)
+    {
+        return whole > 0 ? 100.0 * part / whole : 0.0;
+    }
+
+    double seconds(long ticks, long episodes)
+    {
+        return episodes > 0 ? ticks * static_cast<double>(ThrowTuner::tickDt()) / episodes : 0.0;
+    }
+
+    // hit rate per gravity x flight time, one table per throw animation
+    void printHitRates(const ThrowTuner &tuner)
+    {
+        const ThrowGrid &grid = tuner.grid();
+        const std::vector<ThrowTally> &r = tuner.results();
+        std::printf("\nhit rate %%, gravity down, flightTime across\n");
+        for (size_t a = 0; a < grid.throwAnimDuration.size(); ++a)
+        {
+            std::printf("  throwAnimDuration %.2f s\n  %8s", grid.throwAnimDuration[a], "gravity");
+            for (float f : grid.flightTime)
+                std::printf(" %7.2f", f);
+            std::printf("\n");
+            for (size_t g = 0; g < grid.gravity.size(); ++g)
+            {
+                std::printf("  %8.0f", grid.gravity[g]);
+                for (size_t f = 0; f < grid.flightTime.size(); ++f)
+                {
+                    const ThrowTally &t = r[grid.index(g, f, a)];
+                    std::printf(" %7.2f", rate(t.hits, t.episodes));
+                }
+                std::printf("\n");
+            }
+        }
+    }
+
+    // mean round, release and flight times per gravity x throw animation,
+    // over every flight time
+    void printTimings(const ThrowTuner &tuner)
+    {
+        const ThrowGrid &grid = tuner.grid();
+        const std::vector<ThrowTally> &r = tuner.results();
+        std::printf("\nmean seconds per round (stand to release / flight), gravity down, throwAnimDuration across\n");
+        std::printf("  %8s", "gravity");
+        for (float a : grid.throwAnimDuration)
+            std::printf(" %20.2f", a);
+        std::printf(" %10s %9s\n", "fallback%", "timeout%");
+        for (size_t g = 0; g < grid.gravity.size(); ++g)
+        {
+            std::printf("  %8.0f", grid.gravity[g]);
+            ThrowTally row;
+            for (size_t a = 0; a < grid.throwAnimDuration.size(); ++a)
+            {
+                ThrowTally cell;
+                for (size_t f = 0; f < grid.flightTime.size(); ++f)
+                    cell += r[grid.index(g, f, a)];
+                row += cell;
+                char text[32];
+                std::snprintf(text, sizeof text, "%.2f (%.2f/%.2f)", seconds(cell.ticks, cell.episodes),
+                              seconds(cell.releaseTicks, cell.episodes), seconds(cell.flightTicks, cell.episodes));
+                std::printf(" %20s", text);
+            }
+            std::printf(" %10.2f %9.2f\n", rate(row.fallbacks, row.episodes), rate(row.timeouts, row.episodes));
+        }
+    }
+
+    bool writeCsv(const char *path, const ThrowTuner &tuner)
+    {
+        std::FILE *f = std::fopen(path, "w");
+        if (!f)
+            return false;
+        const ThrowGrid &grid = tuner.grid();
+        std::fprintf(f, "gravity,flight_time,throw_anim_duration,episodes,hits,hit_rate,fallbacks,timeouts,"
+                        "mean_round_s,mean_release_s,mean_flight_s\n");
+        for (size_t g = 0; g < grid.gravity.size(); ++g)
+            for (size_t ft = 0; ft < grid.flightTime.size(); ++ft)
+                for (size_t a = 0; a < grid.throwAnimDuration.size(); ++a)
+                {
+                    const ThrowTally &t = tuner.results()[grid.index(g, ft, a)];
+                    std::fprintf(f, "%g,%g,%g,%ld,%ld,%.4f,%ld,%ld,%.4f,%.4f,%.4f\n", grid.gravity[g],
+                                 grid.flightTime[ft], grid.throwAnimDuration[a], t.episodes, t.hits,
+                                 rate(t.hits, t.episodes) / 100.0, t.fallbacks, t.timeouts,
+                                 seconds(t.ticks, t.episodes), seconds(t.releaseTicks, t.episodes),
+                                 seconds(t.flightTicks, t.episodes));
+                }
+        return std::fclose(f) == 0;
+    }
+}
+
+// usage: oocatcher_tune [--layouts n] [--seed s] [--threads n] [--gravity list] [--flight-time list]
+//                       [--anim list] [--fixed-time] [--csv file] [--verify]
+//   every list is comma separated; --fixed-time throws every ball with the
+//   flight time instead of solving for one; --verify runs the sweep again
+//   on one thread and compares the results
+int main(int argc, char **argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; ++i)
+    {
+        bool ok = true;
+        if (std::strcmp(argv[i], "--layouts") == 0 && i + 1 < argc)
+            ok = (opt.layouts = std::atol(argv[++i])) > 0;
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            opt.seed = std::strtoull(argv[++i], nullptr, 0);
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            opt.threads = static_cast<unsigned>(std::max(std::atoi(argv[++i]), 0));
+        else if (std::strcmp(argv[i], "--gravity") == 0 && i + 1 < argc)
+            ok = parseList(argv[++i], opt.grid.gravity);
+        else if (std::strcmp(argv[i], "--flight-time") == 0 && i + 1 < argc)
+            ok = parseList(argv[++i], opt.grid.flightTime);
+        else if (std::strcmp(argv[i], "--anim") == 0 && i + 1 < argc)
+            ok = parseList(argv[++i], opt.grid.throwAnimDuration);
+        else if (std::strcmp(argv[i], "--fixed-time") == 0)
+            opt.useSolver = false;
+        else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            opt.csvPath = argv[++i];
+        else if (std::strcmp(argv[i], "--verify") == 0)
+            opt.verify = true;
+        else
+        {
+            std::fprintf(stderr, "unknown option '%s'\n", argv[i]);
+            return 1;
+        }
+        if (!ok)
+        {
+            std::fprintf(stderr, "bad value for %s: '%s'\n", argv[i - 1], argv[i]);
+            return 1;
+        }
+    }
+
+    JobSystem jobs(opt.threads);
+    ThrowTuner tuner(opt.grid, opt.seed, opt.useSolver);
+    long episodes = opt.layouts * static_cast<long>(opt.grid.size());
+    std::printf("throw sweep: %ld layouts x %zu parameter sets = %ld episodes on %u threads, %s\n", opt.layouts,
+                opt.grid.size(), episodes, jobs.threadCount(),
+                opt.useSolver ? "solved throws" : "fixed flight time");
+
+    auto begin = std::chrono::steady_clock::now();
+    tuner.run(opt.layouts, jobs);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    printHitRates(tuner);
+    printTimings(tuner);
+    std::printf("\n%ld episodes in %.3f s wall, %.0f episodes/s, results hash %016llx\n", episodes, wall,
+                wall > 0.0 ? episodes / wall : 0.0, static_cast<unsigned long long>(tuner.resultHash()));
+
+    if (opt.csvPath && !writeCsv(opt.csvPath, tuner))
+    {
+        std::fprintf(stderr, "could not write %s\n", opt.csvPath);
+        return 1;
+    }
+    if (opt.verify)
+    {
+        JobSystem one(1);
+        ThrowTuner serial(opt.grid, opt.seed, opt.useSolver);
+        serial.run(opt.layouts, one);
+        bool same = serial.resultHash() == tuner.resultHash();
+        std::printf("same results on 1 thread: %s\n", same ? "yes" : "NO");
+        if (!same)
+            return 1;
+    }
+    return 0;
+}